@@ -1,482 +1,4434 @@
-#include "io_event.h"
-#include "io_event_api.h"
-#include "socket_api.h"
-#include "mem_pool.h"
-#include "hash_map.h"
-#include "log.h"
-#include "thread.h"
-#include "thread_lock.h"
-#include "typedef.h"
-#include "net_error.h"
-#include <string.h>
-
-__thread int net_errno;
-
-//type
-enum ESOCKET_TYPE {
-	EST_UNKNOWN = 0,
-	EST_TCP_SERVER,
-	EST_UDP_SERVER,
-	EST_TCP_CLIENT,
-	EST_UDP_CLIENT
-};
-
-//struct io_handle derived class
-struct io_event_data {
-	SOCKET s; //must first
-
-	enum ESOCKET_TYPE type;
-	unsigned short channel;
-	unsigned short buf_data_len;
-	//option udp only
-	//struct sockaddr peer_addr[0];
-	//option udp/tcp-client only
-	char buf[0]; //NET_BUF_MAX_LEN
-};
-//#define IODT_OFFSET_TCP_BUF(ed) (ed->buf)
-//#define IODT_OFFSET_UDP_BUF(ed) (ed->buf+sizeof(struct sockaddr))
-
-//for hash_map custom function
-static inline int hash_map_isvalid_val(long val) {
-	return (0==val) ? (0) : (1);
-}
-static inline void hash_map_free_val(long val) {
-	if(val) {
-		socket_close( ((struct io_event_data*)val)->s );
-		mem_pool_free((struct io_event_data*)val); 
-	}
-}
-
-struct hash_map *g_mem_hash_map; //<SOCKET, struct io_event_data*>
-struct io_event *g_io_event;
-pfunc_event_notify g_nt_func;
-struct thread_t *g_thread_handle;
-
-static struct tlock_t *g_tlock;
-#define LOCK() lock_lock(g_tlock);
-#define UNLOCK() lock_unlock(g_tlock);
-
-
-static int io_event_join_handle(struct io_handle *hd);
-
-static void thread_run(void *arg);
-static void io_event_notify_handle(struct io_event *ie, const struct io_handle *handle);
-static void io_event_accept_client(struct io_event *ie, struct io_event_data *ed, pfunc_event_notify pf);
-static void io_event_read_udp(struct io_event *ie, struct io_event_data *ed, pfunc_event_notify pf);
-static void io_event_read_tcp(struct io_event *ie, struct io_event_data *ed, pfunc_event_notify pf);
-
-
-int io_event_init(int size, pfunc_event_notify pf)
-{
-	struct hash_map_func hmf;
-
-	if(size<=0 || NULL==pf) {
-		LOG_WARN("[io_event] init failed, param is invalid.");
-		return -1;
-	}
-	
-	if(g_io_event) {
-		LOG_WARN("[io_event] init failed, have inited.");
-		return -1;
-	}
-
-	//init mem pool
-	if(-1==mem_pool_init(10)) {
-		LOG_WARN("[io_event] init failed, init mem_pool failed.");
-		return -1;
-	}
-
-	//thread lock
-	g_tlock = lock_create_critical_section();
-	if(NULL==g_tlock) {
-		LOG_WARN("[io_event] init failed, create thread lock failed.");
-		return -1;
-	}
-
-#ifdef _WIN32
-	if(-1==socket_init_env()) {
-		LOG_WARN("[io_event] init failed, init socket system envirenment failed.");
-		return -1;
-	}
-#endif //_WIN32
-	hash_map_inner_hmf(&hmf, EFI_LONG_LONG);
-	hmf.isvalid_val = hash_map_isvalid_val;
-	hmf.free_val = hash_map_free_val;
-	g_mem_hash_map = hash_map_create(size/2, &hmf);
-	if(NULL==g_mem_hash_map) {
-		LOG_WARN("[io_event] init failed, hash map create failed.");
-		return -1;
-	}
-
-	g_io_event = io_event_create(size);
-	if(NULL==g_io_event) {
-		hash_map_destroy(g_mem_hash_map);
-		LOG_WARN("[io_event] init failed, event create failed.");
-		return -1;
-	}
-
-	g_nt_func = pf;
-
-	return 0;
-}
-
-struct io_handle* io_event_create_tcp(const char *ip, unsigned short port, unsigned short channel)
-{
-	SOCKET s;
-	enum ESOCKET_TYPE type;
-	struct io_event_data *ed=NULL;
-
-	if(NULL==g_io_event) {
-		LOG_WARN("[io_event] create tcp failed, not init.");
-		return NULL;
-	}
-
-	s = socket_create_tcp(ip, port);
-	if(INVALID_SOCKET==s) {
-		LOG_WARN("[io_event] create tcp failed, create socket failed.");
-		return NULL;
-	}
-
-	if(NULL==ip || '\0'==*ip) {
-		//tcp server
-		type = EST_TCP_SERVER;
-		ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data));
-	} else {
-		type = EST_TCP_CLIENT;
-		ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data)+NET_BUF_MAX_LEN);
-	}
-
-	if(ed) {
-		ed->s = s;
-		ed->type = type;
-		ed->channel = channel;
-		ed->buf_data_len = 0;
-
-		//add to io_event
-		if(-1==io_event_join_handle((struct io_handle*)ed)) {
-			LOG_WARN("[io_event] create tcp failed, join handle to io_event failed.");
-			return NULL;
-		}
-	}
-
-	return (struct io_handle*)ed;
-}
-
-struct io_handle* io_event_create_udp(const char *ip, unsigned short port, unsigned short channel)
-{
-	SOCKET s;
-	enum ESOCKET_TYPE type;
-	struct io_event_data *ed=NULL;
-
-	if(NULL==g_io_event) {
-		LOG_WARN("[io_event] create udp failed, not init.");
-		return NULL;
-	}
-
-	s = socket_create_udp(ip, port);
-	if(INVALID_SOCKET==s) {
-		return NULL;
-	}
-
-	if(NULL==ip || '\0'==*ip) {
-		//udp server
-		type = EST_UDP_SERVER;
-		ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data)+/*sizeof(struct sockaddr)+*/NET_BUF_MAX_LEN);
-	} else {
-		type = EST_UDP_CLIENT;
-		ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data)+/*sizeof(struct sockaddr)+*/NET_BUF_MAX_LEN);
-	}
-
-	if(ed) {
-		ed->s = s;
-		ed->type = type;
-		ed->channel = channel;
-		ed->buf_data_len = 0;
-
-		//add to io_event
-		if(-1==io_event_join_handle((struct io_handle*)ed)) {
-			LOG_WARN("[io_event] create udp failed, join handle to io_event failed.");
-			return NULL;
-		}
-	}
-
-	return (struct io_handle*)ed;
-}
-
-void io_event_close_handle(struct io_handle *hd)
-{
-	long s;
-	if(g_io_event && hd) {
-		s = (long)hd->s;
-		LOCK();
-		io_event_del(g_io_event, hd);
-		hash_map_del(g_mem_hash_map, s);
-		UNLOCK();
-		LOG_DEBUG("[io_event] removed socket=%ld from io_event.", s);
-	}
-}
-
-int io_event_send_data(struct io_handle *hd, const char *data, int len)
-{
-	struct io_event_data *ed = (struct io_event_data*)hd;
-
-	if(NULL==ed || NULL==data || 0==len) {
-		LOG_WARN("[io_event] send data failed, param is invalid.");
-		return -1;
-	}
-
-	switch(ed->type) {
-	case EST_UNKNOWN:
-		LOG_WARN("[io_event] send data failed, SOCKET type is unknown.");
-		return -1;
-		break;
-	case EST_TCP_SERVER:
-		LOG_WARN("[io_event] send data failed, SOCKET type is listenning socket which cannot send data on it.");
-		return -1;
-		break;
-	case EST_UDP_SERVER:
-		return socket_send_udp(ed->s, data, len);
-		break;
-	case EST_TCP_CLIENT:
-		return socket_send_tcp(ed->s, data, len);
-		break;
-	case EST_UDP_CLIENT:
-		return socket_send_udp(ed->s, data, len);
-		break;
-	default:
-		return -1;
-		break;
-	}
-}
-
-int io_event_run()
-{
-	if(g_thread_handle) {
-		return -1;
-	}
-
-	if(NULL == (g_thread_handle = thread_create(thread_run, NULL))) {
-		return -1;
-	}
-
-	return 0;
-}
-
-void io_event_stop()
-{
-	io_event_stop_loop(g_io_event);
-	thread_join(&g_thread_handle);
-}
-
-void io_event_release()
-{
-	if(g_io_event) {
-		io_event_stop();
-		io_event_destroy(g_io_event);
-		g_io_event = NULL;
-		hash_map_destroy(g_mem_hash_map);
-		g_mem_hash_map = NULL;
-		lock_destroy(g_tlock);
-		g_tlock = NULL;
-		mem_pool_release();
-	}
-#ifdef _WIN32
-	socket_release_env();
-#endif //_WIN32
-}
-
-static int io_event_join_handle(struct io_handle *hd)
-{
-	////struct io_event_data *ed = (struct io_event_data*)hd;
-
-	//thread lock
-	LOCK();
-
-	//add mem pointer to hash_map
-	if(-1==hash_map_add(g_mem_hash_map, (long)hd->s, (long)hd)) {
-		mem_pool_free(hd);
-		LOG_WARN("[io_event] join io_handle to io_event, add data to hash_map failed.");
-		UNLOCK();
-		return -1;
-	}
-	//add to io_event object
-	if(-1==io_event_add(g_io_event, hd)) {
-		hash_map_del(g_mem_hash_map, (long)hd->s);
-		LOG_WARN("[io_event] join io_handle to io_event, add data to io_event failed.");
-		UNLOCK();
-		return -1;
-	}
-
-	UNLOCK();
-
-	LOG_DEBUG("[io_event] join socket=%ld to io_event ok.", (long)hd->s);
-
-	return 0;
-}
-
-static void thread_run(void *arg)
-{
-	//use variable only for compiler
-	(void)arg;
-	io_event_loop(g_io_event, io_event_notify_handle);
-}
-
-static void io_event_notify_handle(struct io_event *ie, const struct io_handle *handle)
-{
-	struct io_event_data *ed = (struct io_event_data*)handle;
-
-	switch(ed->type) {
-		case EST_TCP_SERVER://accept
-			LOG_DEBUG("[io_event] have event on socket=%ld, type=TCP-S.", (long)ed->s);
-			io_event_accept_client(ie, ed, g_nt_func);
-			break;
-		case EST_UDP_SERVER://read
-			LOG_DEBUG("[io_event] have event on socket=%ld, type=UDP-S.", (long)ed->s);
-			io_event_read_udp(ie, ed, g_nt_func);
-			break;
-		case EST_TCP_CLIENT://read
-			LOG_DEBUG("[io_event] have event on socket=%ld, type=TCP-C.", (long)ed->s);
-			io_event_read_tcp(ie, ed, g_nt_func);
-			break;
-		case EST_UDP_CLIENT://read
-			LOG_DEBUG("[io_event] have event on socket=%ld, type=UDP-C.", (long)ed->s);
-			io_event_read_udp(ie, ed, g_nt_func);
-			break;
-		default:
-		//case EST_UNKNOWN:
-			LOG_WARN("[io_event] handle event failed, socket=%ld type is unknow", (long)ed->s);
-			break;
-	}
-}
-
-static void io_event_accept_client(struct io_event *ie, struct io_event_data *ed, pfunc_event_notify pf)
-{
-	SOCKET c;
-	struct io_event_data *newed;
-	struct sockaddr_in addr;
-	struct event_notify_data nd;
-
-	//use variable only for compiler
-	(void)ie;
-
-	if(0==socket_accept_client(ed->s, &c, (struct sockaddr*)&addr)) {
-		LOG_DEBUG("[io_event] handle event and accept new tcp client=%d [%s:%d] successfully", 
-				c, socket_convert_val2ip(addr.sin_addr.s_addr), addr.sin_port);
-
-		//add to io monitor
-		newed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data));
-		if(newed) {
-			newed->s = c;
-			newed->type = EST_TCP_CLIENT;
-			newed->channel = ed->channel;
-			newed->buf_data_len = 0;
-
-			//add to io_event
-			if(-1==io_event_join_handle((struct io_handle*)ed)) {
-				LOG_WARN("[io_event] handle event and accept new client failed at listening socket=%d, join handle to io_event failed.", ed->s);
-				return ;
-			}
-			
-			//notify outside
-			nd.type = ENT_ACCEPT;
-			nd.data = NULL;
-			nd.len = 0;
-			pf((struct io_handle*)ed, ed->channel, &nd);
-		}
-		else {
-			LOG_WARN("[io_event] handle event and accept new client failed at listening socket=%d, create io_handle failed.", ed->s);
-		}
-	}
-	else {
-		LOG_WARN("[io_event] handle event and accept new client failed at listening socket=%d.", ed->s);
-	}
-}
-
-static void io_event_read_udp(struct io_event *ie, struct io_event_data *ed, pfunc_event_notify pf)
-{
-	int recv_len;
-	unsigned int proc_len;
-	int left_len = NET_BUF_MAX_LEN - ed->buf_data_len;
-	struct event_notify_data nd;
-
-	//use variable only for compiler
-	(void)ie;
-
-	if(left_len <= 0) {
-		LOG_WARN("[io_event] handle event and there is no space to receive udp data at client=%d.", ed->s);
-		return ;
-	}
-
-	recv_len = socket_recv_udp(ed->s, /*&ed->peer_addr,*/ ed->buf+ed->buf_data_len, left_len);
-	if(recv_len>0) {
-		LOG_DEBUG("[io_event] recv data len=%d from socket=%ld, type=UDP-C.", recv_len, (long)ed->s);
-		ed->buf_data_len += recv_len;
-		//notify outside
-		nd.type = ENT_DATA;
-		nd.data = ed->buf;
-		nd.len = ed->buf_data_len;
-		proc_len = pf((struct io_handle*)ed, ed->channel, &nd);
-		if(proc_len>0 && proc_len<=ed->buf_data_len) {
-			memmove(ed->buf, ed->buf+proc_len, ed->buf_data_len-proc_len);
-			ed->buf_data_len -= proc_len;
-		} else {
-			LOG_WARN("[io_event] handle event and read udp data len=%d, but proc_len=%d is invalid", recv_len, proc_len);
-		}
-	}
-	else if(0==recv_len) {
-		//closed
-		nd.type = ENT_CLOSE;
-		nd.data = NULL;
-		nd.len = 0;
-		pf((struct io_handle*)ed, ed->channel, &nd);
-		io_event_close_handle((struct io_handle*)ed);
-	}
-	else {
-		LOG_WARN("[io_event] handle event and read udp client=%d data failed.", ed->s);
-	}
-}
-
-static void io_event_read_tcp(struct io_event *ie, struct io_event_data *ed, pfunc_event_notify pf)
-{
-	int recv_len;
-	unsigned int proc_len;
-	int left_len = NET_BUF_MAX_LEN - ed->buf_data_len;
-	struct event_notify_data nd;
-
-	//use variable only for compiler
-	(void)ie;
-
-	if(left_len <= 0) {
-		LOG_WARN("[io_event] handle event and there is no space to receive tcp data at client=%d.", ed->s);
-		return ;
-	}
-	
-	recv_len = socket_recv_tcp(ed->s, ed->buf+ed->buf_data_len, NET_BUF_MAX_LEN-ed->buf_data_len);
-	if(recv_len>0) {
-		LOG_DEBUG("[io_event] recv data len=%d from socket=%ld, type=TCP-C.", recv_len, (long)ed->s);
-		ed->buf_data_len += recv_len;
-		//notify outside
-		nd.type = ENT_DATA;
-		nd.data = ed->buf;
-		nd.len = ed->buf_data_len;
-		proc_len = pf((struct io_handle*)ed, ed->channel, &nd);
-		if(proc_len>0 && proc_len<=ed->buf_data_len) {
-			memmove(ed->buf, ed->buf+proc_len, ed->buf_data_len-proc_len);
-			ed->buf_data_len -= proc_len;
-		} else {
-			LOG_WARN("[io_event] handle event and read tcp data len=%d, but proc_len=%d is invalid", recv_len, proc_len);
-		}
-	}
-	else if(0==recv_len) {
-		//closed
-		nd.type = ENT_CLOSE;
-		nd.data = NULL;
-		nd.len = 0;
-		pf((struct io_handle*)ed, ed->channel, &nd);
-		io_event_close_handle((struct io_handle*)ed);
-	}
-	else {
-		LOG_WARN("[io_event] handle event and read tcp client=%d data failed.", ed->s);
-	}
-}
-
+#include "io_event.h"
+#include "io_event_api.h"
+#include "socket_api.h"
+#include "mem_pool.h"
+#include "hash_map.h"
+#include "log.h"
+#include "thread.h"
+#include "thread_lock.h"
+#include "thread_wait.h"
+#include "atomic.h"
+#include "timer_wheel.h"
+#include "typedef.h"
+#include "net_error.h"
+#include <string.h>
+#include <stdlib.h>
+#ifndef _WIN32
+  #include <unistd.h>
+  #include <errno.h>
+#endif //_WIN32
+
+//max accepted clients of one listening event
+#define NET_ACCEPT_BUDGET (64)
+//milliseconds of accepting again after running out of fd, such as EMFILE
+#define NET_ACCEPT_RETRY (100)
+//max recvmmsg calls of one udp event
+#define NET_UDP_ROUND_MAX (4)
+//max cached hosts of resolving, the least recently resolved are dropped first
+#define NET_RESOLVE_CACHE_MAX (1024)
+
+//reactor buffer of tcp reading, the data is copied to connection only if pending
+#define NET_READ_BUF_LEN (1024*64)
+
+//max SO_RCVLOWAT set for the missing bytes of frame
+#define NET_RCVLOWAT_MAX (1024*32)
+
+//handle id: generation<<32 | reactor<<24 | socket
+#define IO_ID_SOCKET_BITS (24)
+#define IO_ID_REACTOR_MAX (256)
+
+//capacity of outbound buffer node
+#define NET_OUT_NODE_SIZE (1024*4)
+
+//max posted sends of one handle merged to one writev
+#define NET_CMD_IOV_MAX (64)
+
+//reasons of paused reading
+#define IO_PAUSE_WORKER (0x01) //queue of worker is full
+#define IO_PAUSE_USER   (0x02) //io_event_pause_read
+#define IO_PAUSE_BUF    (0x04) //pending data reach recv_high_watermark
+#define IO_PAUSE_ACCEPT (0x08) //joined, ENT_ACCEPT is not notified
+
+//state of connection in pool
+#define IO_POOL_USED       (0) //got by user
+#define IO_POOL_CONNECTING (1) //warming
+#define IO_POOL_IDLE       (2) //warm and idle
+#define IO_POOL_DROPPED    (3) //removed from pool and closing, events are ignored
+
+__thread int net_errno;
+
+//type
+enum ESOCKET_TYPE {
+	EST_UNKNOWN = 0,
+	EST_TCP_SERVER,
+	EST_UDP_SERVER,
+	EST_TCP_CLIENT,
+	EST_UDP_CLIENT,
+	EST_UDP_SESSION //peer of udp server, share the server socket
+};
+
+//command posted to reactor
+enum EIO_CMD_TYPE {
+	EICT_SEND = 0,
+	EICT_CLOSE,
+	EICT_TASK,
+	EICT_RESUME  //resume reading paused by worker, arg is pinned handle
+};
+//posted by any thread, it is allocated by malloc instead of mem_pool,
+//whose global lock serializes the posting threads with every reactor
+struct io_cmd {
+	struct io_cmd *next;
+	enum EIO_CMD_TYPE type;
+	unsigned long long id;
+	pfunc_reactor_task pf;
+	void *arg;
+	unsigned int len;
+	char data[0];
+};
+
+//event notified in worker thread
+struct io_work {
+	struct io_work *next;
+	struct io_event_data *ed; //pinned
+	enum EEV_NOTIFY_TYPE type;
+	int len;
+	struct sockaddr_in addr; //peer address of ENT_ACCEPT
+	char data[0];
+};
+struct io_worker {
+	struct thread_t *th;
+	struct thread_wait_t *tw;
+	struct tlock_t *tlock;
+	//protected by tlock
+	struct io_work *head;
+	struct io_work *tail;
+	unsigned int count;  //queued and in processing
+	struct io_event_data *paused; //handles paused by full queue, pinned
+	int stop;
+};
+
+//outbound connection pool, keyed by server and channel
+struct io_pool_key {
+	unsigned int ip;
+	unsigned short port;
+	unsigned short channel;
+};
+//option of channel, the handles refer to the version when created,
+//so a new version is added instead of changing it, an old version is freed
+//when no handle refers to it, except the first one kept in g_channel_opts
+struct io_channel_ver {
+	struct io_channel_opt opt;   //must first
+	unsigned int refs;           //handles referring to it, protected by g_opt_tlock
+	struct io_channel_ver *prev; //older version
+	struct io_channel_ver *next; //newer version
+	struct io_channel_ver *last; //newest version, only kept by the first one in g_channel_opts
+};
+struct io_pool {
+	struct io_pool_key key; //must first, key of g_pools
+	char ip[16];
+	struct io_pool_opt opt;
+	struct io_event_data *head; //connections of pool except the dropped, pinned, linked by pool_next
+	unsigned int idle;          //idle connections in list
+	unsigned int connecting;    //warming connections, with the reserved for refilling
+	unsigned int used;          //connections got by user and not put or closed
+	struct io_timer *timer;     //health check
+};
+
+//cached resolving of host
+struct io_dns {
+	char host[NET_HOST_LEN]; //key of g_dns_cache
+	unsigned long long expire; //milliseconds of timer_wheel_now
+	int resolving;
+	int count; //ips, 0 failed
+	unsigned int ips[NET_RESOLVE_IP_MAX];
+	struct io_cmd *waits; //results of requests, allocated before resolving, linked by next
+	struct io_dns *next; //queue of resolver
+	struct io_dns *lru_prev; //cache order by resolved time
+	struct io_dns *lru_next;
+};
+//resolving result notified in reactor
+struct io_dns_result {
+	pfunc_resolve_notify pf;
+	void *arg;
+	int count;
+	unsigned int ips[NET_RESOLVE_IP_MAX];
+	char host[NET_HOST_LEN];
+};
+//thread of blocking getaddrinfo, protected by g_dns_tlock
+struct io_resolver {
+	struct thread_t *th;
+	struct thread_wait_t *tw;
+	struct io_dns *head;
+	struct io_dns *tail;
+	int stop;
+};
+
+//connection slot of reactor, indexed by socket
+struct io_slot {
+	struct io_event_data *ed;
+	unsigned int gen; //bumped when a handle takes the slot, never 0
+};
+
+//reactor, one io_event loop with its own connection table and thread
+struct io_reactor {
+	int id;
+	struct io_event *ie;
+	struct io_slot *slots; //connection table, protected by tlock
+	unsigned int slot_count;
+	struct tlock_t *tlock;
+	struct thread_t *th;
+	struct timer_wheel *tw; //timers driven by loop, protected by tlock
+	struct udp_msg *udp_msgs; //batch of udp receiving, only used by reactor thread
+	char *read_buf; //NET_READ_BUF_LEN, tcp receiving, only used by reactor thread
+	//handles that used up read budget, resumed by next loop, protected by tlock
+	struct io_event_data *ready_head;
+	struct io_event_data *ready_tail;
+	unsigned int ready_count;
+	//closed handles, protected by tlock, released after one more loop
+	//so the events completed before deleting are dropped
+	struct io_event_data *free_head;
+	struct io_event_data *free_wait;
+	//unpinned ones in free_wait, the pinned are released after io_event_unpin wakes it
+	unsigned int free_ready;
+	//commands posted by other threads, lock-free stack, newest first
+	long volatile cmd_head;
+};
+
+//timer
+struct io_timer {
+	struct timer_node node; //must first
+	struct io_reactor *rt;
+	pfunc_timer_notify pf;
+	void *arg;
+	unsigned int interval;
+	int firing;    //pf is being called
+	int cancelled; //cancelled while firing, freed after pf
+};
+
+//outbound buffer chain node
+struct io_buf_node {
+	struct io_buf_node *next;
+	unsigned int size; //capacity of data
+	unsigned int off;  //offset of unsent data
+	unsigned int len;  //end of data
+	const char *ext;   //data of zerocopy send, not copied into data
+	unsigned int zc_id;    //number of first zerocopy send call
+	unsigned int zc_count; //zerocopy send calls
+	unsigned int zc_done;  //completed zerocopy send calls
+	char data[0];
+};
+#define IO_BUF_NODE_DATA(bn) ((bn)->ext ? (bn)->ext : (bn)->data)
+
+//struct io_handle derived class
+struct io_event_data {
+	SOCKET s; //must first
+	unsigned int events; //must second, monitored io events
+	void *backend; //must third, state of io_uring backend
+
+	struct io_reactor *rt; //owner reactor
+	const struct io_channel_opt *opt;
+	enum ESOCKET_TYPE type;
+	unsigned short channel;
+	//pending data not processed by callback, tcp-client only,
+	//allocated from mem pool while data is pending
+	char *rbuf;
+	unsigned int rbuf_size;
+	unsigned int rbuf_off; //start of pending data, advanced by processed data
+	unsigned int buf_data_len;
+	unsigned int frame_scan; //pending data searched for delimiter
+	unsigned int rcvlowat;   //SO_RCVLOWAT of socket
+	unsigned int idle_timeout; //milliseconds, 0 disabled
+	unsigned long long active_time; //last time of recv/send, for idle_timeout
+	struct io_timer *idle_timer;
+	//io_event_connect_async in progress, protected by rt->tlock
+	int connecting;
+	struct io_timer *conn_timer;
+	struct io_timer *accept_timer; //tcp server only, accept again after EMFILE
+	//outbound pool, protected by g_pool_tlock
+	struct io_pool *pool;   //owner pool, NULL not pooled
+	int pool_state;         //IO_POOL_xxx
+	unsigned long long pool_time; //time of being idle
+	struct io_event_data *pool_next;
+	//outbound queue, protected by rt->tlock
+	struct io_buf_node *out_head;
+	struct io_buf_node *out_tail;
+	unsigned int out_len; //queued bytes
+	int out_high;         //ENT_SEND_HIGH notified, wait for ENT_SEND_LOW
+	int sending;          //a thread writes socket outside rt->tlock, the others queue data
+	//monitored events are changed outside rt->tlock by one thread at a time
+	int modding;
+	int mod_again;        //interest changed while modding
+	//zerocopy send, protected by rt->tlock
+	unsigned int zc_threshold; //bytes, 0 disabled
+	int zc_copied;             //kernel copies, the data of zerocopy send is copied by us
+	unsigned int zc_next;      //number of next zerocopy send call
+	struct io_buf_node *zc_head; //sent nodes wait for completion
+	struct io_buf_node *zc_tail;
+	//udp server only, protected by rt->tlock
+	struct hash_map *sessions; //<struct sockaddr_in*, struct io_event_data*>
+	unsigned int session_timeout; //milliseconds, idle timeout of sessions
+	//udp session only
+	struct io_event_data *server;
+	//ready list of reactor, protected by rt->tlock
+	struct io_event_data *ready_prev;
+	struct io_event_data *ready_next;
+	int ready; //in ready list
+	unsigned int read_paused; //reasons of paused reading, IO_PAUSE_xxx, protected by rt->tlock
+	int renotify; //pending data is notified again after resuming
+	int drain;    //read until EAGAIN after resuming, edges are missed while paused
+	struct io_event_data *pause_next; //in paused list of worker
+	//closing, protected by rt->tlock
+	int closed;         //closed and waiting for release, no more event is handled
+	unsigned int refs;  //pinned by io_event_xxx_id in other threads, not released
+	struct io_event_data *free_next;
+	//option udp session: struct sockaddr_in peer_addr
+	char buf[0];
+};
+#define IODT_PEER_ADDR(ed) ((struct sockaddr_in*)(ed)->buf)
+
+#define LOCK(rt) lock_lock((rt)->tlock);
+#define UNLOCK(rt) lock_unlock((rt)->tlock);
+
+//for hash_map custom function
+static inline void channel_opt_free_val(long val) {
+	struct io_channel_ver *ver = (struct io_channel_ver*)val;
+	struct io_channel_ver *next;
+	for(; ver; ver=next) {
+		next = ver->next;
+		mem_pool_free(ver);
+	}
+}
+static inline int hash_map_isvalid_val(long val) {
+	return (0==val) ? (0) : (1);
+}
+static void io_event_out_free(struct io_event_data *ed);
+static const struct io_channel_opt* io_event_channel_opt_get(unsigned short channel);
+static void io_event_channel_opt_put(const struct io_channel_opt *opt);
+//release handle removed from connection table
+static inline void io_event_data_free(struct io_event_data *ed) {
+	if(ed->idle_timer) {
+		io_event_timer_cancel(ed->idle_timer);
+	}
+	if(ed->conn_timer) {
+		io_event_timer_cancel(ed->conn_timer);
+	}
+	if(ed->accept_timer) {
+		io_event_timer_cancel(ed->accept_timer);
+	}
+	if(ed->sessions) {
+		LOCK(ed->rt);
+		hash_map_destroy(ed->sessions);
+		UNLOCK(ed->rt);
+	}
+	io_event_out_free(ed);
+	if(ed->rbuf) {
+		mem_pool_free(ed->rbuf);
+	}
+	socket_close(ed->s);
+	io_event_channel_opt_put(ed->opt);
+	mem_pool_free(ed);
+}
+//udp session map, key is peer address in session
+static inline unsigned long session_hash(long key) {
+	const struct sockaddr_in *addr = (const struct sockaddr_in*)key;
+	unsigned long hs = (unsigned long)addr->sin_addr.s_addr;
+	//hash*33 + c
+	return ((hs<<5) + hs) + addr->sin_port;
+}
+static inline int session_compare(long src_key, long dst_key) {
+	const struct sockaddr_in *s = (const struct sockaddr_in*)src_key;
+	const struct sockaddr_in *d = (const struct sockaddr_in*)dst_key;
+	if(s->sin_addr.s_addr!=d->sin_addr.s_addr) {
+		return (s->sin_addr.s_addr>d->sin_addr.s_addr) ? (1) : (-1);
+	}
+	return (s->sin_port>d->sin_port) ? (1) : ((s->sin_port<d->sin_port) ? (-1) : (0));
+}
+static void io_event_timer_cancel_locked(struct io_timer *timer);
+static inline void session_free_val(long val) {
+	//called with rt->tlock, the socket is owned by server,
+	//released by next loop because the loop may be dispatching it
+	struct io_event_data *sd = (struct io_event_data*)val;
+	if(sd) {
+		if(sd->idle_timer) {
+			io_event_timer_cancel_locked(sd->idle_timer);
+			sd->idle_timer = NULL;
+		}
+		sd->closed = 1;
+		sd->free_next = sd->rt->free_head;
+		sd->rt->free_head = sd;
+	}
+}
+//connection pool map, key is struct io_pool_key in pool
+static inline unsigned long pool_hash(long key) {
+	const struct io_pool_key *k = (const struct io_pool_key*)key;
+	unsigned long hs = (unsigned long)k->ip;
+	//hash*33 + c
+	hs = ((hs<<5) + hs) + k->port;
+	return ((hs<<5) + hs) + k->channel;
+}
+static inline int pool_compare(long src_key, long dst_key) {
+	const struct io_pool_key *s = (const struct io_pool_key*)src_key;
+	const struct io_pool_key *d = (const struct io_pool_key*)dst_key;
+	if(s->ip!=d->ip) {
+		return (s->ip>d->ip) ? (1) : (-1);
+	}
+	if(s->port!=d->port) {
+		return (s->port>d->port) ? (1) : (-1);
+	}
+	return (s->channel>d->channel) ? (1) : ((s->channel<d->channel) ? (-1) : (0));
+}
+static inline void pool_free_val(long val) {
+	//called after reactors stop, the timer is released by its reactor
+	struct io_pool *pool = (struct io_pool*)val;
+	struct io_event_data *ed;
+	if(pool) {
+		while(NULL != (ed = pool->head)) {
+			pool->head = ed->pool_next;
+			--ed->refs;
+		}
+		mem_pool_free(pool);
+	}
+}
+//resolving cache map, key is host in struct io_dns
+static inline unsigned long dns_hash(long key) {
+	const unsigned char *c = (const unsigned char*)key;
+	unsigned long hs = 5381;
+	while(*c) {
+		//hash*33 + c
+		hs = ((hs<<5) + hs) + *c++;
+	}
+	return hs;
+}
+static inline int dns_compare(long src_key, long dst_key) {
+	return strcmp((const char*)src_key, (const char*)dst_key);
+}
+static inline void dns_free_val(long val) {
+	//called after resolvers stop, the waiting requests are dropped
+	struct io_dns *dns = (struct io_dns*)val;
+	struct io_cmd *wait;
+	if(dns) {
+		while(NULL != (wait = dns->waits)) {
+			dns->waits = wait->next;
+			free(wait);
+		}
+		mem_pool_free(dns);
+	}
+}
+
+static inline void io_event_data_init(struct io_event_data *ed, SOCKET s, enum ESOCKET_TYPE type, unsigned short channel) {
+	ed->s = s;
+	ed->events = 0;
+	ed->backend = NULL;
+	ed->rt = NULL;
+	ed->opt = io_event_channel_opt_get(channel);
+	ed->type = type;
+	ed->channel = channel;
+	ed->rbuf = NULL;
+	ed->rbuf_size = 0;
+	ed->rbuf_off = 0;
+	ed->buf_data_len = 0;
+	ed->frame_scan = 0;
+	ed->rcvlowat = 1;
+	ed->idle_timeout = 0;
+	ed->active_time = 0;
+	ed->idle_timer = NULL;
+	ed->connecting = 0;
+	ed->conn_timer = NULL;
+	ed->accept_timer = NULL;
+	ed->pool = NULL;
+	ed->pool_state = IO_POOL_USED;
+	ed->pool_time = 0;
+	ed->pool_next = NULL;
+	ed->out_head = NULL;
+	ed->out_tail = NULL;
+	ed->out_len = 0;
+	ed->out_high = 0;
+	ed->sending = 0;
+	ed->modding = 0;
+	ed->mod_again = 0;
+	ed->zc_threshold = 0;
+	ed->zc_copied = 0;
+	ed->zc_next = 0;
+	ed->zc_head = NULL;
+	ed->zc_tail = NULL;
+	ed->sessions = NULL;
+	ed->session_timeout = 0;
+	ed->server = NULL;
+	ed->ready_prev = NULL;
+	ed->ready_next = NULL;
+	ed->ready = 0;
+	ed->read_paused = 0;
+	ed->renotify = 0;
+	ed->drain = 0;
+	ed->pause_next = NULL;
+	ed->closed = 0;
+	ed->refs = 0;
+	ed->free_next = NULL;
+}
+
+//refresh active time for idle timeout
+static inline void io_event_data_active(struct io_event_data *ed) {
+	if(ed->idle_timer) {
+		ed->active_time = timer_wheel_now();
+	}
+}
+
+static struct io_reactor *g_reactors;
+static int g_reactor_count;
+static long volatile g_reactor_next; //round robin index for new handle
+static pfunc_event_notify g_nt_func;
+static enum EIO_BACKEND g_backend = EIB_EPOLL;
+
+//channel options
+static struct hash_map *g_channel_opts; //<channel, struct io_channel_ver*>
+static struct tlock_t *g_opt_tlock;
+static const struct io_channel_opt g_default_opt = {
+	/*send_high_watermark*/ 1024*1024,
+	/*send_low_watermark*/  1024*64,
+	/*listen_backlog*/      0,
+	/*read_budget*/         NET_READ_BUDGET,
+	/*recv_buf_max*/        NET_RECV_BUF_MAX,
+	/*recv_high_watermark*/ 0,
+	/*framer*/              {EFT_NONE, 0, 0, 0, 0, 0, 0, {0}},
+	/*worker*/              0,
+	/*connect_fastopen*/    0
+};
+static struct io_worker *g_workers;
+static int g_worker_count;
+static unsigned int g_worker_queue = NET_WORKER_QUEUE;
+//connection pools
+static struct hash_map *g_pools; //<struct io_pool_key*, struct io_pool*>
+static struct tlock_t *g_pool_tlock;
+//resolvers and cache
+static struct io_resolver *g_resolvers; //started by first resolving
+static int g_resolver_count = NET_RESOLVER_THREAD;
+static unsigned int g_resolve_ttl = NET_RESOLVE_TTL;
+static unsigned int g_resolve_neg_ttl = NET_RESOLVE_NEG_TTL;
+static struct hash_map *g_dns_cache; //<char*, struct io_dns*>
+static struct io_dns *g_dns_head; //the least recently resolved
+static struct io_dns *g_dns_tail;
+static struct tlock_t *g_dns_tlock;
+
+//the reactor that current thread is looping on
+static __thread struct io_reactor *t_reactor;
+
+
+static int io_event_reactor_init(struct io_reactor *rt, int id, int size);
+static void io_event_reactor_release(struct io_reactor *rt);
+static struct io_reactor* io_event_next_reactor();
+static int io_event_join_handle(struct io_reactor *rt, struct io_handle *hd);
+static int io_event_join_locked(struct io_reactor *rt, struct io_handle *hd);
+static int io_event_slot_add_locked(struct io_reactor *rt, struct io_event_data *ed);
+static struct io_event_data* io_event_slot_del_locked(struct io_reactor *rt, SOCKET s);
+static struct io_event_data* io_event_pin(unsigned long long id);
+static void io_event_unpin(struct io_event_data *ed);
+static void io_event_free_closed(struct io_reactor *rt);
+static int io_event_post_cmd(struct io_cmd *cmd);
+static void io_event_run_cmds(struct io_reactor *rt);
+static void io_event_send_cmds(struct io_cmd *cmd, int cnt);
+static int io_event_workers_init();
+static void io_event_workers_release();
+static void worker_run(void *arg);
+static unsigned int io_event_dispatch(struct io_event_data *ed, struct event_notify_data *nd);
+static int io_event_worker_push(struct io_event_data *ed, struct event_notify_data *nd);
+static void io_event_read_pause(struct io_event_data *ed, unsigned int reason);
+static void io_event_read_resume(struct io_event_data *ed, unsigned int reason);
+static unsigned int io_event_interest(struct io_event_data *ed);
+static int io_event_read_data(struct io_event_data *ed, char *data, unsigned int len);
+static void io_event_ready_add(struct io_event_data *ed);
+static void io_event_ready_del_locked(struct io_event_data *ed);
+
+static int io_event_reactor_hook(struct io_event *ie, void *arg);
+static void io_event_idle_check(struct io_timer *timer, void *arg);
+static struct io_timer* io_event_timer_add_locked(struct io_reactor *rt, unsigned int timeout, unsigned int interval, pfunc_timer_notify pf, void *arg);
+static int io_event_timer_rearm_locked(struct io_timer *timer, unsigned int timeout);
+static void io_event_connect_done(struct io_event_data *ed, int err);
+static void io_event_connect_timeout(struct io_timer *timer, void *arg);
+static struct io_event_data* io_event_connect_handle(const char *ip, unsigned short port, unsigned short channel, unsigned int timeout, struct io_pool *pool, int state);
+static int io_event_pools_init();
+static void io_event_pools_release();
+static struct io_pool* io_event_pool_find_locked(const char *ip, unsigned short port, unsigned short channel);
+static void io_event_pool_move_locked(struct io_pool *pool, struct io_event_data *ed, int state);
+static void io_event_pool_fill(struct io_pool *pool, unsigned int count);
+static unsigned int io_event_pool_reserve_locked(struct io_pool *pool);
+static int io_event_pool_notify(struct io_event_data *ed, struct event_notify_data *nd);
+static void io_event_pool_check(struct io_timer *timer, void *arg);
+static int io_event_dns_init();
+static void io_event_dns_release();
+static void io_event_dns_touch_locked(struct io_dns *dns);
+static void io_event_dns_evict_locked(unsigned long long now);
+static int io_event_resolvers_start_locked();
+static void resolver_run(void *arg);
+static struct io_cmd* io_event_resolve_cmd(struct io_reactor *rt, const char *host, pfunc_resolve_notify pf, void *arg);
+static int io_event_resolve_post(struct io_reactor *rt, const char *host, const unsigned int *ips, int count, pfunc_resolve_notify pf, void *arg);
+static void io_event_resolve_notify(void *arg);
+
+static int io_event_send_tcpv(struct io_event_data *ed, const struct iovec *iov, int cnt, int len);
+static int io_event_out_append(struct io_event_data *ed, const char *data, unsigned int len);
+static int io_event_out_flush(struct io_event_data *ed);
+static int io_event_out_prepend(struct io_event_data *ed, const struct iovec *iov, int cnt, size_t off);
+static int io_event_out_queued(struct io_event_data *ed, unsigned int *queued);
+static int io_event_out_own_locked(struct io_event_data *ed);
+static int io_event_out_release_locked(struct io_event_data *ed);
+static int io_event_interest_begin_locked(struct io_event_data *ed);
+static void io_event_interest_apply(struct io_event_data *ed);
+static int io_event_send_zerocopy(struct io_event_data *ed, const char *data, int len);
+static void io_event_zerocopy_complete(struct io_event_data *ed);
+static struct io_buf_node* io_event_zerocopy_reap(struct io_event_data *ed);
+static void io_event_zerocopy_notify(struct io_event_data *ed, struct io_buf_node *done);
+
+static void thread_run(void *arg);
+static void io_event_notify_handle(struct io_event *ie, const struct io_handle *handle, unsigned int events);
+static void io_event_notify_simple(struct io_event_data *ed, enum EEV_NOTIFY_TYPE type, int len);
+static void io_event_write_tcp(struct io_event_data *ed, pfunc_event_notify pf);
+static void io_event_accept_client(struct io_event *ie, struct io_event_data *ed);
+static void io_event_accept_retry(struct io_timer *timer, void *arg);
+static void io_event_read_udp(struct io_event *ie, struct io_event_data *ed, pfunc_event_notify pf);
+static struct io_event_data* io_event_udp_session(struct io_event_data *ed, const struct sockaddr_in *addr, pfunc_event_notify pf);
+static struct udp_msg* io_event_udp_msgs(struct io_reactor *rt);
+static void io_event_read_tcp(struct io_event *ie, struct io_event_data *ed);
+static int io_event_rbuf_keep(struct io_event_data *ed, const char *data, unsigned int len, unsigned int proc_len);
+static int io_event_notify_tcp(struct io_event_data *ed, char *data, unsigned int len);
+static int io_event_frame_len(struct io_event_data *ed, const char *data, unsigned int len, unsigned int *need);
+static void io_event_frame_lowat(struct io_event_data *ed, unsigned int need);
+static int io_event_rbuf_space(struct io_event_data *ed);
+
+
+int io_event_init(int size, pfunc_event_notify pf)
+{
+	return io_event_init_ex(size, 1, pf);
+}
+
+int io_event_init_ex(int size, int reactor_count, pfunc_event_notify pf)
+{
+	int i;
+	struct hash_map_func hmf;
+
+	if(size<=0 || NULL==pf) {
+		LOG_WARN("[io_event] init failed, param is invalid.");
+		return -1;
+	}
+	
+	if(g_reactors) {
+		LOG_WARN("[io_event] init failed, have inited.");
+		return -1;
+	}
+
+	if(reactor_count<=0) {
+#ifdef _WIN32
+		reactor_count = 1;
+#else
+		reactor_count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+		reactor_count = (reactor_count<=0) ? 1 : reactor_count;
+#endif //_WIN32
+	}
+	if(reactor_count>size) {
+		reactor_count = size;
+	}
+
+	//init mem pool
+	if(-1==mem_pool_init(10)) {
+		LOG_WARN("[io_event] init failed, init mem_pool failed.");
+		return -1;
+	}
+
+#ifdef _WIN32
+	if(-1==socket_init_env()) {
+		LOG_WARN("[io_event] init failed, init socket system envirenment failed.");
+		return -1;
+	}
+#endif //_WIN32
+
+	//channel options
+	g_opt_tlock = lock_create_critical_section();
+	if(NULL==g_opt_tlock) {
+		LOG_WARN("[io_event] init failed, create thread lock failed.");
+		return -1;
+	}
+	hash_map_inner_hmf(&hmf, EFI_LONG_LONG);
+	hmf.free_val = channel_opt_free_val;
+	g_channel_opts = hash_map_create(16, &hmf);
+	if(NULL==g_channel_opts) {
+		lock_destroy(g_opt_tlock);
+		g_opt_tlock = NULL;
+		LOG_WARN("[io_event] init failed, hash map create failed.");
+		return -1;
+	}
+
+	g_reactors = (struct io_reactor*)mem_pool_malloc(sizeof(struct io_reactor)*reactor_count);
+	if(NULL==g_reactors) {
+		hash_map_destroy(g_channel_opts);
+		g_channel_opts = NULL;
+		lock_destroy(g_opt_tlock);
+		g_opt_tlock = NULL;
+		LOG_WARN("[io_event] init failed, malloc reactors failed.");
+		return -1;
+	}
+	memset(g_reactors, 0, sizeof(struct io_reactor)*reactor_count);
+
+	//every reactor monitor part of the sockets
+	for(i=0;i<reactor_count;++i) {
+		if(-1==io_event_reactor_init(&g_reactors[i], i, (size+reactor_count-1)/reactor_count)) {
+			LOG_WARN("[io_event] init failed, init reactor=%d failed.", i);
+			while(i-- > 0) {
+				io_event_reactor_release(&g_reactors[i]);
+			}
+			mem_pool_free(g_reactors);
+			g_reactors = NULL;
+			hash_map_destroy(g_channel_opts);
+			g_channel_opts = NULL;
+			lock_destroy(g_opt_tlock);
+			g_opt_tlock = NULL;
+			return -1;
+		}
+	}
+
+	g_reactor_count = reactor_count;
+	g_reactor_next = 0;
+	g_nt_func = pf;
+
+	if(g_worker_count>0 && -1==io_event_workers_init()) {
+		LOG_WARN("[io_event] init failed, init workers failed.");
+		io_event_release();
+		return -1;
+	}
+
+	if(-1==io_event_pools_init()) {
+		LOG_WARN("[io_event] init failed, init connection pools failed.");
+		io_event_release();
+		return -1;
+	}
+
+	if(-1==io_event_dns_init()) {
+		LOG_WARN("[io_event] init failed, init resolving cache failed.");
+		io_event_release();
+		return -1;
+	}
+
+	return 0;
+}
+
+int io_event_set_backend(enum EIO_BACKEND backend)
+{
+	if(backend<EIB_EPOLL || backend>EIB_URING) {
+		LOG_WARN("[io_event] set backend failed, param is invalid.");
+		return -1;
+	}
+
+	if(g_reactors) {
+		LOG_WARN("[io_event] set backend failed, have inited.");
+		return -1;
+	}
+
+	g_backend = backend;
+	return 0;
+}
+
+int io_event_set_worker(int worker_count, unsigned int queue_len)
+{
+	if(worker_count<0) {
+		LOG_WARN("[io_event] set worker failed, param is invalid.");
+		return -1;
+	}
+
+	if(g_reactors) {
+		LOG_WARN("[io_event] set worker failed, have inited.");
+		return -1;
+	}
+
+	g_worker_count = worker_count;
+	g_worker_queue = (queue_len) ? (queue_len) : (NET_WORKER_QUEUE);
+	return 0;
+}
+
+int io_event_set_resolver(int thread_count, unsigned int ttl, unsigned int neg_ttl)
+{
+	if(g_reactors) {
+		LOG_WARN("[io_event] set resolver failed, have inited.");
+		return -1;
+	}
+
+	g_resolver_count = (thread_count>0) ? (thread_count) : (NET_RESOLVER_THREAD);
+	g_resolve_ttl = (ttl>0) ? (ttl) : (NET_RESOLVE_TTL);
+	g_resolve_neg_ttl = (neg_ttl>0) ? (neg_ttl) : (NET_RESOLVE_NEG_TTL);
+	return 0;
+}
+
+int io_event_get_channel_opt(unsigned short channel, struct io_channel_opt *opt)
+{
+	const struct io_channel_opt *ref;
+
+	if(NULL==opt) {
+		LOG_WARN("[io_event] get channel option failed, param is invalid.");
+		return -1;
+	}
+
+	ref = io_event_channel_opt_get(channel);
+	memcpy(opt, ref, sizeof(struct io_channel_opt));
+	io_event_channel_opt_put(ref);
+	return 0;
+}
+
+int io_event_set_channel_opt(unsigned short channel, const struct io_channel_opt *opt)
+{
+	long val;
+	struct io_channel_ver *ver, *first, *old;
+
+	if(NULL==opt || opt->send_low_watermark > opt->send_high_watermark) {
+		LOG_WARN("[io_event] set channel option failed, param is invalid.");
+		return -1;
+	}
+	if((EFT_LENGTH==opt->framer.type && 1!=opt->framer.len_width && 2!=opt->framer.len_width && 4!=opt->framer.len_width)
+		|| (EFT_DELIMITER==opt->framer.type && (0==opt->framer.delim_len || opt->framer.delim_len>sizeof(opt->framer.delim)))
+		|| (EFT_FIXED==opt->framer.type && 0==opt->framer.fixed_size)
+		|| opt->framer.type<EFT_NONE || opt->framer.type>EFT_FIXED) {
+		LOG_WARN("[io_event] set channel option failed, framer is invalid.");
+		return -1;
+	}
+	if(NULL==g_channel_opts) {
+		LOG_WARN("[io_event] set channel option failed, not init.");
+		return -1;
+	}
+
+	ver = (struct io_channel_ver*)mem_pool_malloc(sizeof(struct io_channel_ver));
+	if(NULL==ver) {
+		LOG_WARN("[io_event] set channel option failed, mem_pool_malloc failed.");
+		return -1;
+	}
+	memcpy(&ver->opt, opt, sizeof(struct io_channel_opt));
+	ver->refs = 0;
+	ver->prev = NULL;
+	ver->next = NULL;
+	ver->last = ver;
+
+	lock_lock(g_opt_tlock);
+	if(0==hash_map_find(g_channel_opts, (long)channel, &val)) {
+		//the handles of channel refer to the old version without lock,
+		//it is released by the last of them, the first one is kept as the head
+		first = (struct io_channel_ver*)val;
+		old = first->last;
+		old->next = ver;
+		ver->prev = old;
+		first->last = ver;
+		if(old!=first && 0==old->refs) {
+			old->prev->next = ver;
+			ver->prev = old->prev;
+		}
+		else {
+			old = NULL;
+		}
+		lock_unlock(g_opt_tlock);
+		if(old) {
+			mem_pool_free(old);
+		}
+		return 0;
+	}
+	if(-1==hash_map_add(g_channel_opts, (long)channel, (long)ver)) {
+		lock_unlock(g_opt_tlock);
+		mem_pool_free(ver);
+		LOG_WARN("[io_event] set channel option failed, add to hash_map failed.");
+		return -1;
+	}
+	lock_unlock(g_opt_tlock);
+
+	return 0;
+}
+
+struct io_handle* io_event_create_tcp(const char *ip, unsigned short port, unsigned short channel)
+{
+	SOCKET s;
+	enum ESOCKET_TYPE type;
+	struct io_event_data *ed=NULL;
+	const struct io_channel_opt *opt;
+
+	if(NULL==g_reactors) {
+		LOG_WARN("[io_event] create tcp failed, not init.");
+		return NULL;
+	}
+
+	opt = io_event_channel_opt_get(channel);
+	s = socket_create_tcp_ex(ip, port, opt->listen_backlog);
+	io_event_channel_opt_put(opt);
+	if(INVALID_SOCKET==s) {
+		LOG_WARN("[io_event] create tcp failed, create socket failed.");
+		return NULL;
+	}
+
+	if(NULL==ip || '\0'==*ip) {
+		//tcp server
+		type = EST_TCP_SERVER;
+		ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data));
+	} else {
+		type = EST_TCP_CLIENT;
+		ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data));
+	}
+
+	if(ed) {
+		io_event_data_init(ed, s, type, channel);
+
+		//add to io_event
+		if(-1==io_event_join_handle(io_event_next_reactor(), (struct io_handle*)ed)) {
+			socket_close(s);
+			io_event_channel_opt_put(ed->opt);
+			mem_pool_free(ed);
+			LOG_WARN("[io_event] create tcp failed, join handle to io_event failed.");
+			return NULL;
+		}
+	} else {
+		socket_close(s);
+	}
+
+	return (struct io_handle*)ed;
+}
+
+struct io_handle* io_event_connect_async(const char *ip, unsigned short port, unsigned short channel, unsigned int timeout)
+{
+	if(NULL==g_reactors) {
+		LOG_WARN("[io_event] connect async failed, not init.");
+		return NULL;
+	}
+
+	return (struct io_handle*)io_event_connect_handle(ip, port, channel, timeout, NULL, IO_POOL_USED);
+}
+
+int io_event_resolve(const char *host, struct io_handle *hd, pfunc_resolve_notify pf, void *arg)
+{
+	int count;
+	long val;
+	unsigned long long now;
+	unsigned int ips[NET_RESOLVE_IP_MAX];
+	struct io_reactor *rt;
+	struct io_dns *dns;
+	struct io_cmd *wait;
+	struct io_resolver *r = NULL;
+
+	if(NULL==g_reactors || NULL==host || '\0'==*host || strlen(host)>=NET_HOST_LEN || NULL==pf) {
+		LOG_WARN("[io_event] resolve failed, param is invalid or not init.");
+		return -1;
+	}
+
+	rt = (hd) ? ((struct io_event_data*)hd)->rt : io_event_next_reactor();
+	now = timer_wheel_now();
+	lock_lock(g_dns_tlock);
+	dns = (0==hash_map_find(g_dns_cache, (long)host, &val)) ? ((struct io_dns*)val) : (NULL);
+	if(dns && !dns->resolving && now<dns->expire) {
+		//cached, notified by loop as resolved
+		count = dns->count;
+		memcpy(ips, dns->ips, sizeof(ips));
+		lock_unlock(g_dns_tlock);
+		return io_event_resolve_post(rt, host, ips, count, pf, arg);
+	}
+	if(-1==io_event_resolvers_start_locked()) {
+		lock_unlock(g_dns_tlock);
+		LOG_WARN("[io_event] resolve failed, start resolvers failed.");
+		return -1;
+	}
+	//the result is posted without allocating, so pf is never dropped
+	wait = io_event_resolve_cmd(rt, host, pf, arg);
+	if(NULL==dns) {
+		dns = (struct io_dns*)mem_pool_malloc(sizeof(struct io_dns));
+		if(NULL==dns || NULL==wait) {
+			lock_unlock(g_dns_tlock);
+			if(dns) {
+				mem_pool_free(dns);
+			}
+			if(wait) {
+				free(wait);
+			}
+			LOG_WARN("[io_event] resolve failed, mem_pool_malloc failed.");
+			return -1;
+		}
+		memset(dns, 0, sizeof(struct io_dns));
+		strcpy(dns->host, host);
+		io_event_dns_evict_locked(now);
+		if(-1==hash_map_add(g_dns_cache, (long)dns->host, (long)dns)) {
+			lock_unlock(g_dns_tlock);
+			mem_pool_free(dns);
+			free(wait);
+			LOG_WARN("[io_event] resolve failed, add %s to cache failed.", host);
+			return -1;
+		}
+		io_event_dns_touch_locked(dns);
+	} else if(NULL==wait) {
+		lock_unlock(g_dns_tlock);
+		LOG_WARN("[io_event] resolve failed, mem_pool_malloc failed.");
+		return -1;
+	}
+	wait->next = dns->waits;
+	dns->waits = wait;
+	//the concurrent requests share one resolving
+	if(!dns->resolving) {
+		dns->resolving = 1;
+		dns->next = NULL;
+		r = &g_resolvers[dns_hash((long)host) % (unsigned long)g_resolver_count];
+		if(r->tail) {
+			r->tail->next = dns;
+		} else {
+			r->head = dns;
+		}
+		r->tail = dns;
+	}
+	lock_unlock(g_dns_tlock);
+
+	if(r) {
+		thread_wait_signal(r->tw);
+	}
+
+	return 0;
+}
+
+int io_event_pool_create(const char *ip, unsigned short port, unsigned short channel, const struct io_pool_opt *opt)
+{
+	unsigned int count;
+	struct io_pool *pool;
+
+	if(NULL==g_reactors || NULL==ip || strlen(ip)>=sizeof(pool->ip) || 0==port || NULL==opt || 0==opt->idle_count) {
+		LOG_WARN("[io_event] create pool failed, param is invalid or not init.");
+		return -1;
+	}
+
+	pool = (struct io_pool*)mem_pool_malloc(sizeof(struct io_pool));
+	if(NULL==pool) {
+		LOG_WARN("[io_event] create pool failed, mem_pool_malloc failed.");
+		return -1;
+	}
+	pool->key.ip = socket_convert_ip2val(ip);
+	pool->key.port = port;
+	pool->key.channel = channel;
+	strcpy(pool->ip, ip);
+	pool->opt = *opt;
+	if(0==pool->opt.check_interval) {
+		pool->opt.check_interval = NET_POOL_CHECK_INTERVAL;
+	}
+	pool->head = NULL;
+	pool->idle = 0;
+	pool->connecting = 0;
+	pool->used = 0;
+
+	lock_lock(g_pool_tlock);
+	if(io_event_pool_find_locked(ip, port, channel) || -1==hash_map_add(g_pools, (long)&pool->key, (long)pool)) {
+		lock_unlock(g_pool_tlock);
+		mem_pool_free(pool);
+		LOG_WARN("[io_event] create pool failed, pool of %s:%d channel=%d exists or add failed.", ip, port, channel);
+		return -1;
+	}
+	pool->timer = io_event_timer_add(NULL, pool->opt.check_interval, pool->opt.check_interval, io_event_pool_check, pool);
+	if(NULL==pool->timer) {
+		//nothing is linked yet, the pool is freed by pool_free_val
+		hash_map_del(g_pools, (long)&pool->key);
+		lock_unlock(g_pool_tlock);
+		LOG_WARN("[io_event] create pool failed, add health check timer failed.");
+		return -1;
+	}
+	count = io_event_pool_reserve_locked(pool);
+	lock_unlock(g_pool_tlock);
+
+	//warm up
+	io_event_pool_fill(pool, count);
+
+	return 0;
+}
+
+struct io_handle* io_event_pool_get(const char *ip, unsigned short port, unsigned short channel, int *connected)
+{
+	unsigned int count;
+	struct io_pool *pool;
+	struct io_event_data *ed, *next, *closed = NULL;
+
+	if(NULL==g_reactors || NULL==connected) {
+		LOG_WARN("[io_event] get from pool failed, param is invalid or not init.");
+		return NULL;
+	}
+
+	lock_lock(g_pool_tlock);
+	pool = io_event_pool_find_locked(ip, port, channel);
+	if(NULL==pool) {
+		lock_unlock(g_pool_tlock);
+		LOG_WARN("[io_event] get from pool failed, no pool of %s:%d channel=%d.", (ip) ? (ip) : (""), port, channel);
+		return NULL;
+	}
+	//the latest idle is the head, it is the warmest
+	for(ed=pool->head; ed; ed=next) {
+		next = ed->pool_next;
+		if(IO_POOL_IDLE!=ed->pool_state) {
+			continue;
+		}
+		if(!ed->closed) {
+			//the pin is kept for user until put or closed
+			io_event_pool_move_locked(pool, ed, IO_POOL_USED);
+			break;
+		}
+		io_event_pool_move_locked(pool, ed, IO_POOL_DROPPED);
+		ed->pool_next = closed;
+		closed = ed;
+	}
+	if(NULL==ed) {
+		//count the new connection first, or the reserve exceeds the limit
+		++pool->used;
+	}
+	count = io_event_pool_reserve_locked(pool);
+	lock_unlock(g_pool_tlock);
+
+	while(NULL != (next = closed)) {
+		closed = next->pool_next;
+		io_event_unpin(next);
+	}
+	if(ed) {
+		*connected = 1;
+	} else {
+		ed = io_event_connect_handle(ip, port, channel, pool->opt.connect_timeout, pool, IO_POOL_USED);
+		if(NULL==ed) {
+			lock_lock(g_pool_tlock);
+			--pool->used;
+			lock_unlock(g_pool_tlock);
+		}
+		*connected = 0;
+	}
+	io_event_pool_fill(pool, count);
+
+	return (struct io_handle*)ed;
+}
+
+void io_event_pool_put(struct io_handle *hd)
+{
+	int keep = 0;
+	struct io_pool *pool;
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || NULL==ed->pool) {
+		LOG_WARN("[io_event] put to pool failed, param is invalid.");
+		return ;
+	}
+
+	pool = ed->pool;
+	lock_lock(g_pool_tlock);
+	if(IO_POOL_USED!=ed->pool_state) {
+		lock_unlock(g_pool_tlock);
+		LOG_WARN("[io_event] put to pool failed, socket=%ld is in pool.", (long)ed->s);
+		return ;
+	}
+	//pending data or paused reading belongs to the former user
+	LOCK(ed->rt);
+	keep = (!ed->closed && !ed->connecting && 0==ed->buf_data_len && 0==ed->read_paused
+		&& pool->idle<pool->opt.idle_count);
+	UNLOCK(ed->rt);
+	io_event_pool_move_locked(pool, ed, (keep) ? (IO_POOL_IDLE) : (IO_POOL_DROPPED));
+	lock_unlock(g_pool_tlock);
+
+	if(!keep) {
+		io_event_close_handle(hd);
+		io_event_unpin(ed);
+	}
+}
+
+struct io_handle* io_event_create_udp(const char *ip, unsigned short port, unsigned short channel)
+{
+	SOCKET s;
+	enum ESOCKET_TYPE type;
+	struct io_event_data *ed=NULL;
+
+	if(NULL==g_reactors) {
+		LOG_WARN("[io_event] create udp failed, not init.");
+		return NULL;
+	}
+
+	s = socket_create_udp(ip, port);
+	if(INVALID_SOCKET==s) {
+		return NULL;
+	}
+
+	if(NULL==ip || '\0'==*ip) {
+		//udp server
+		type = EST_UDP_SERVER;
+		ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data));
+	} else {
+		type = EST_UDP_CLIENT;
+		ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data));
+	}
+
+	if(ed) {
+		io_event_data_init(ed, s, type, channel);
+
+		//add to io_event
+		if(-1==io_event_join_handle(io_event_next_reactor(), (struct io_handle*)ed)) {
+			socket_close(s);
+			io_event_channel_opt_put(ed->opt);
+			mem_pool_free(ed);
+			LOG_WARN("[io_event] create udp failed, join handle to io_event failed.");
+			return NULL;
+		}
+	} else {
+		socket_close(s);
+	}
+
+	return (struct io_handle*)ed;
+}
+
+void io_event_close_handle(struct io_handle *hd)
+{
+	long s;
+	int unpin = 0;
+	struct io_reactor *rt;
+	struct io_event_data *ed = (struct io_event_data*)hd;
+	if(g_reactors && hd) {
+		s = (long)hd->s;
+		rt = ed->rt;
+		if(ed->pool && IO_POOL_USED==ed->pool_state) {
+			//closed by user instead of putting back, the pin of user is dropped after closing
+			lock_lock(g_pool_tlock);
+			if(IO_POOL_USED==ed->pool_state) {
+				io_event_pool_move_locked(ed->pool, ed, IO_POOL_DROPPED);
+				unpin = 1;
+			}
+			lock_unlock(g_pool_tlock);
+		}
+		LOCK(rt);
+		if(ed->closed) {
+			UNLOCK(rt);
+			if(unpin) {
+				io_event_unpin(ed);
+			}
+			return ;
+		}
+		ed->closed = 1;
+		if(ed->idle_timer) {
+			io_event_timer_cancel_locked(ed->idle_timer);
+			ed->idle_timer = NULL;
+		}
+		if(ed->conn_timer) {
+			io_event_timer_cancel_locked(ed->conn_timer);
+			ed->conn_timer = NULL;
+		}
+		if(ed->accept_timer) {
+			io_event_timer_cancel_locked(ed->accept_timer);
+			ed->accept_timer = NULL;
+		}
+		if(EST_UDP_SESSION==ed->type) {
+			//the socket is owned by server
+			hash_map_del(ed->server->sessions, (long)IODT_PEER_ADDR(ed));
+			UNLOCK(rt);
+			return ;
+		}
+		io_event_ready_del_locked(ed);
+		io_event_del(rt->ie, hd);
+		io_event_slot_del_locked(rt, hd->s);
+		//the loop or other threads may still refer to it, the socket is
+		//closed by next loop, so it is not reused before that
+		ed->free_next = rt->free_head;
+		rt->free_head = ed;
+		UNLOCK(rt);
+		if(t_reactor!=rt) {
+			io_event_wakeup(rt->ie);
+		}
+		LOG_DEBUG("[io_event] removed socket=%ld from io_event of reactor=%d.", s, rt->id);
+		if(unpin) {
+			io_event_unpin(ed);
+		}
+	}
+}
+
+unsigned long long io_event_handle_id(const struct io_handle *hd)
+{
+	unsigned long long id = 0;
+	const struct io_event_data *ed = (const struct io_event_data*)hd;
+
+	if(NULL==ed || NULL==ed->rt || EST_UDP_SESSION==ed->type
+		|| (unsigned long)ed->s>=(1UL<<IO_ID_SOCKET_BITS) || ed->rt->id>=IO_ID_REACTOR_MAX) {
+		LOG_WARN("[io_event] get handle id failed, param is invalid.");
+		return 0;
+	}
+
+	LOCK(ed->rt);
+	if(!ed->closed && (unsigned long)ed->s<ed->rt->slot_count && ed->rt->slots[ed->s].ed==ed) {
+		id = ((unsigned long long)ed->rt->slots[ed->s].gen<<32)
+			| ((unsigned long long)ed->rt->id<<IO_ID_SOCKET_BITS) | (unsigned long long)ed->s;
+	}
+	UNLOCK(ed->rt);
+
+	return id;
+}
+
+int io_event_send_id(unsigned long long id, const char *data, int len)
+{
+	int ret;
+	struct io_event_data *ed = io_event_pin(id);
+
+	if(NULL==ed) {
+		return -1;
+	}
+	ret = io_event_send_data((struct io_handle*)ed, data, len);
+	io_event_unpin(ed);
+
+	return ret;
+}
+
+int io_event_close_id(unsigned long long id)
+{
+	struct io_event_data *ed = io_event_pin(id);
+
+	if(NULL==ed) {
+		return -1;
+	}
+	io_event_close_handle((struct io_handle*)ed);
+	io_event_unpin(ed);
+
+	return 0;
+}
+
+int io_event_pause_read(struct io_handle *hd)
+{
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || EST_TCP_CLIENT!=ed->type || ed->closed) {
+		LOG_WARN("[io_event] pause reading failed, param is invalid.");
+		return -1;
+	}
+
+	io_event_read_pause(ed, IO_PAUSE_USER);
+	return 0;
+}
+
+int io_event_resume_read(struct io_handle *hd)
+{
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || EST_TCP_CLIENT!=ed->type || ed->closed) {
+		LOG_WARN("[io_event] resume reading failed, param is invalid.");
+		return -1;
+	}
+
+	io_event_read_resume(ed, IO_PAUSE_USER|IO_PAUSE_BUF);
+	return 0;
+}
+
+int io_event_post_send(unsigned long long id, const char *data, int len)
+{
+	struct io_cmd *cmd;
+
+	if(0==id || NULL==data || len<=0) {
+		LOG_WARN("[io_event] post send failed, param is invalid.");
+		return -1;
+	}
+
+	cmd = (struct io_cmd*)malloc(sizeof(struct io_cmd)+len);
+	if(NULL==cmd) {
+		LOG_WARN("[io_event] post send failed, malloc len=%d failed.", len);
+		return -1;
+	}
+	cmd->type = EICT_SEND;
+	cmd->id = id;
+	cmd->len = (unsigned int)len;
+	memcpy(cmd->data, data, len);
+
+	return io_event_post_cmd(cmd);
+}
+
+int io_event_post_close(unsigned long long id)
+{
+	struct io_cmd *cmd;
+
+	if(0==id) {
+		LOG_WARN("[io_event] post close failed, param is invalid.");
+		return -1;
+	}
+
+	cmd = (struct io_cmd*)malloc(sizeof(struct io_cmd));
+	if(NULL==cmd) {
+		LOG_WARN("[io_event] post close failed, malloc failed.");
+		return -1;
+	}
+	cmd->type = EICT_CLOSE;
+	cmd->id = id;
+	cmd->len = 0;
+
+	return io_event_post_cmd(cmd);
+}
+
+int io_event_post_task(unsigned long long id, pfunc_reactor_task pf, void *arg)
+{
+	struct io_cmd *cmd;
+
+	if(0==id || NULL==pf) {
+		LOG_WARN("[io_event] post task failed, param is invalid.");
+		return -1;
+	}
+
+	cmd = (struct io_cmd*)malloc(sizeof(struct io_cmd));
+	if(NULL==cmd) {
+		LOG_WARN("[io_event] post task failed, malloc failed.");
+		return -1;
+	}
+	cmd->type = EICT_TASK;
+	cmd->id = id;
+	cmd->pf = pf;
+	cmd->arg = arg;
+	cmd->len = 0;
+
+	return io_event_post_cmd(cmd);
+}
+
+int io_event_send_data(struct io_handle *hd, const char *data, int len)
+{
+	struct iovec iov;
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || NULL==data || 0==len) {
+		LOG_WARN("[io_event] send data failed, param is invalid.");
+		return -1;
+	}
+	if(ed->closed) {
+		LOG_DEBUG("[io_event] send data failed, socket=%ld is closed.", (long)ed->s);
+		return -1;
+	}
+
+	switch(ed->type) {
+	case EST_UNKNOWN:
+		LOG_WARN("[io_event] send data failed, SOCKET type is unknown.");
+		return -1;
+		break;
+	case EST_TCP_SERVER:
+		LOG_WARN("[io_event] send data failed, SOCKET type is listenning socket which cannot send data on it.");
+		return -1;
+		break;
+	case EST_UDP_SERVER:
+		io_event_data_active(ed);
+		return socket_send_udp(ed->s, data, len);
+		break;
+	case EST_TCP_CLIENT:
+		io_event_data_active(ed);
+		if(ed->zc_threshold && (unsigned int)len>=ed->zc_threshold) {
+			return io_event_send_zerocopy(ed, data, len);
+		}
+		iov.iov_base = (void*)data;
+		iov.iov_len = (size_t)len;
+		return io_event_send_tcpv(ed, &iov, 1, len);
+		break;
+	case EST_UDP_CLIENT:
+		io_event_data_active(ed);
+		return socket_send_udp(ed->s, data, len);
+		break;
+	case EST_UDP_SESSION:
+		io_event_data_active(ed);
+		return socket_send_udp_to(ed->s, IODT_PEER_ADDR(ed), data, len);
+		break;
+	default:
+		return -1;
+		break;
+	}
+}
+
+int io_event_send_udp_to(struct io_handle *hd, const struct sockaddr *addr, const char *data, int len)
+{
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || NULL==addr || NULL==data || 0==len
+		|| (EST_UDP_SERVER!=ed->type && EST_UDP_CLIENT!=ed->type && EST_UDP_SESSION!=ed->type)) {
+		LOG_WARN("[io_event] send udp data failed, param is invalid.");
+		return -1;
+	}
+	if(ed->closed) {
+		LOG_DEBUG("[io_event] send udp data failed, socket=%ld is closed.", (long)ed->s);
+		return -1;
+	}
+
+	io_event_data_active(ed);
+	return socket_send_udp_to(ed->s, (const struct sockaddr_in*)addr, data, len);
+}
+
+int io_event_set_udp_session(struct io_handle *hd, unsigned int size, unsigned int idle_timeout)
+{
+	struct hash_map_func hmf;
+	struct hash_map *sessions;
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || EST_UDP_SERVER!=ed->type || 0==size) {
+		LOG_WARN("[io_event] set udp session failed, param is invalid.");
+		return -1;
+	}
+
+	hash_map_inner_hmf(&hmf, EFI_LONG_LONG);
+	hmf.hash = session_hash;
+	hmf.compare = session_compare;
+	hmf.isvalid_key = hash_map_isvalid_val;
+	hmf.isvalid_val = hash_map_isvalid_val;
+	hmf.free_val = session_free_val;
+	sessions = hash_map_create(size, &hmf);
+	if(NULL==sessions) {
+		LOG_WARN("[io_event] set udp session failed, hash map create failed.");
+		return -1;
+	}
+
+	LOCK(ed->rt);
+	if(ed->sessions) {
+		//have enabled, only modify timeout of new sessions
+		ed->session_timeout = idle_timeout;
+		UNLOCK(ed->rt);
+		hash_map_destroy(sessions);
+		return 0;
+	}
+	ed->sessions = sessions;
+	ed->session_timeout = idle_timeout;
+	UNLOCK(ed->rt);
+
+	return 0;
+}
+
+int io_event_send_datav(struct io_handle *hd, const struct iovec *iov, int cnt)
+{
+	int i;
+	size_t len = 0;
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || NULL==iov || cnt<=0) {
+		LOG_WARN("[io_event] send data failed, param is invalid.");
+		return -1;
+	}
+	if(ed->closed) {
+		LOG_DEBUG("[io_event] send data failed, socket=%ld is closed.", (long)ed->s);
+		return -1;
+	}
+	for(i=0; i<cnt; ++i) {
+		len += iov[i].iov_len;
+	}
+	if(0==len || len>0x7fffffff) {
+		LOG_WARN("[io_event] send data failed, data len=%lu is invalid.", (unsigned long)len);
+		return -1;
+	}
+
+	switch(ed->type) {
+	case EST_TCP_CLIENT:
+		io_event_data_active(ed);
+		return io_event_send_tcpv(ed, iov, cnt, (int)len);
+		break;
+	case EST_UDP_SERVER:
+	case EST_UDP_CLIENT:
+		//one datagram
+		io_event_data_active(ed);
+		return socket_send_udpv(ed->s, NULL, iov, cnt);
+		break;
+	case EST_UDP_SESSION:
+		io_event_data_active(ed);
+		return socket_send_udpv(ed->s, IODT_PEER_ADDR(ed), iov, cnt);
+		break;
+	default:
+		LOG_WARN("[io_event] send data failed, SOCKET type cannot send data on it.");
+		return -1;
+		break;
+	}
+}
+
+int io_event_send_udp_batch(struct io_handle *hd, const struct udp_msg *msgs, int cnt)
+{
+	int ret;
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || NULL==msgs || cnt<=0 || (EST_UDP_SERVER!=ed->type && EST_UDP_CLIENT!=ed->type)) {
+		LOG_WARN("[io_event] send udp batch failed, param is invalid.");
+		return -1;
+	}
+	if(ed->closed) {
+		LOG_DEBUG("[io_event] send udp batch failed, socket=%ld is closed.", (long)ed->s);
+		return -1;
+	}
+
+	io_event_data_active(ed);
+	ret = socket_send_udp_batch(ed->s, msgs, cnt, 1);
+	if(ret<0) {
+		LOG_WARN("[io_event] send udp batch failed at socket=%ld, errno=%d.", (long)ed->s, errno);
+	}
+
+	return ret;
+}
+
+struct io_timer* io_event_timer_add(struct io_handle *hd, unsigned int timeout, unsigned int interval, pfunc_timer_notify pf, void *arg)
+{
+	struct io_timer *timer;
+	struct io_reactor *rt;
+
+	if(NULL==g_reactors || NULL==pf) {
+		LOG_WARN("[io_event] add timer failed, param is invalid or not init.");
+		return NULL;
+	}
+
+	//the timer is driven by the reactor of hd, so pf runs in the same thread with hd events
+	rt = (hd) ? ((struct io_event_data*)hd)->rt : io_event_next_reactor();
+	LOCK(rt);
+	timer = io_event_timer_add_locked(rt, timeout, interval, pf, arg);
+	UNLOCK(rt);
+
+	if(timer && t_reactor!=rt) {
+		//the loop may be waiting with a later timeout
+		io_event_wakeup(rt->ie);
+	}
+
+	return timer;
+}
+
+static struct io_timer* io_event_timer_add_locked(struct io_reactor *rt, unsigned int timeout, unsigned int interval, pfunc_timer_notify pf, void *arg)
+{
+	struct io_timer *timer;
+
+	timer = (struct io_timer*)mem_pool_malloc(sizeof(struct io_timer));
+	if(NULL==timer) {
+		LOG_WARN("[io_event] add timer failed, mem_pool_malloc failed.");
+		return NULL;
+	}
+	timer->node.prev = NULL;
+	timer->node.next = NULL;
+	timer->rt = rt;
+	timer->pf = pf;
+	timer->arg = arg;
+	timer->interval = interval;
+	timer->firing = 0;
+	timer->cancelled = 0;
+	timer_wheel_add(rt->tw, &timer->node, timer_wheel_now()+timeout);
+
+	return timer;
+}
+
+int io_event_timer_rearm(struct io_timer *timer, unsigned int timeout)
+{
+	struct io_reactor *rt;
+
+	if(NULL==timer) {
+		LOG_WARN("[io_event] rearm timer failed, param is invalid.");
+		return -1;
+	}
+
+	rt = timer->rt;
+	LOCK(rt);
+	if(-1==io_event_timer_rearm_locked(timer, timeout)) {
+		UNLOCK(rt);
+		return -1;
+	}
+	UNLOCK(rt);
+
+	if(t_reactor!=rt) {
+		io_event_wakeup(rt->ie);
+	}
+
+	return 0;
+}
+
+static int io_event_timer_rearm_locked(struct io_timer *timer, unsigned int timeout)
+{
+	if(timer->cancelled) {
+		return -1;
+	}
+	timer_wheel_del(timer->rt->tw, &timer->node);
+	timer_wheel_add(timer->rt->tw, &timer->node, timer_wheel_now()+timeout);
+
+	return 0;
+}
+
+void io_event_timer_cancel(struct io_timer *timer)
+{
+	struct io_reactor *rt;
+
+	if(NULL==timer) {
+		return ;
+	}
+
+	rt = timer->rt;
+	LOCK(rt);
+	io_event_timer_cancel_locked(timer);
+	UNLOCK(rt);
+}
+
+static void io_event_timer_cancel_locked(struct io_timer *timer)
+{
+	timer_wheel_del(timer->rt->tw, &timer->node);
+	if(timer->firing) {
+		//freed by loop after pf returns
+		timer->cancelled = 1;
+		return ;
+	}
+
+	mem_pool_free(timer);
+}
+
+int io_event_set_idle_timeout(struct io_handle *hd, unsigned int timeout)
+{
+	int ret = 0;
+	struct io_reactor *rt;
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || NULL==ed->rt || EST_TCP_SERVER==ed->type) {
+		LOG_WARN("[io_event] set idle timeout failed, param is invalid.");
+		return -1;
+	}
+
+	//the timer wheel is expired by reactor, and the timer is cancelled by closing
+	rt = ed->rt;
+	LOCK(rt);
+	if(ed->closed) {
+		UNLOCK(rt);
+		return -1;
+	}
+	ed->idle_timeout = timeout;
+	if(0==timeout) {
+		if(ed->idle_timer) {
+			io_event_timer_cancel_locked(ed->idle_timer);
+			ed->idle_timer = NULL;
+		}
+		UNLOCK(rt);
+		return 0;
+	}
+
+	//the timer checks active time when expired, so recv/send only refresh active time
+	ed->active_time = timer_wheel_now();
+	if(ed->idle_timer) {
+		ret = io_event_timer_rearm_locked(ed->idle_timer, timeout);
+	} else {
+		ed->idle_timer = io_event_timer_add_locked(rt, timeout, 0, io_event_idle_check, ed);
+		ret = (ed->idle_timer) ? (0) : (-1);
+	}
+	UNLOCK(rt);
+
+	if(t_reactor!=rt) {
+		//the wait of reactor may be longer than the timeout
+		io_event_wakeup(rt->ie);
+	}
+
+	return ret;
+}
+
+int io_event_set_zerocopy(struct io_handle *hd, unsigned int threshold)
+{
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || EST_TCP_CLIENT!=ed->type) {
+		LOG_WARN("[io_event] set zerocopy failed, param is invalid.");
+		return -1;
+	}
+	if(threshold && -1==socket_set_zerocopy(ed->s)) {
+		LOG_WARN("[io_event] set zerocopy failed at socket=%ld, not supported.", (long)ed->s);
+		return -1;
+	}
+
+	LOCK(ed->rt);
+	ed->zc_threshold = threshold;
+	UNLOCK(ed->rt);
+
+	return 0;
+}
+
+int io_event_set_udp_gro(struct io_handle *hd, int enable)
+{
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	if(NULL==ed || (EST_UDP_SERVER!=ed->type && EST_UDP_CLIENT!=ed->type)) {
+		LOG_WARN("[io_event] set udp gro failed, param is invalid.");
+		return -1;
+	}
+	if(-1==socket_set_udp_gro(ed->s, enable)) {
+		LOG_WARN("[io_event] set udp gro failed at socket=%ld, not supported.", (long)ed->s);
+		return -1;
+	}
+
+	return 0;
+}
+
+int io_event_run()
+{
+	int i;
+
+	if(NULL==g_reactors || g_reactors[0].th) {
+		return -1;
+	}
+
+	for(i=0;i<g_reactor_count;++i) {
+		if(NULL == (g_reactors[i].th = thread_create(thread_run, &g_reactors[i]))) {
+			LOG_WARN("[io_event] run failed, create thread for reactor=%d failed.", i);
+			io_event_stop();
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+void io_event_stop()
+{
+	int i;
+
+	if(NULL==g_reactors) {
+		return ;
+	}
+
+	for(i=0;i<g_reactor_count;++i) {
+		io_event_stop_loop(g_reactors[i].ie);
+	}
+	for(i=0;i<g_reactor_count;++i) {
+		thread_join(&g_reactors[i].th);
+	}
+}
+
+void io_event_release()
+{
+	int i;
+
+	if(g_reactors) {
+		io_event_stop();
+		//the queued events and pools pin handles
+		io_event_workers_release();
+		io_event_pools_release();
+		//resolvers post results to reactors
+		io_event_dns_release();
+		for(i=0;i<g_reactor_count;++i) {
+			io_event_reactor_release(&g_reactors[i]);
+		}
+		mem_pool_free(g_reactors);
+		g_reactors = NULL;
+		g_reactor_count = 0;
+		hash_map_destroy(g_channel_opts);
+		g_channel_opts = NULL;
+		lock_destroy(g_opt_tlock);
+		g_opt_tlock = NULL;
+		mem_pool_release();
+	}
+#ifdef _WIN32
+	socket_release_env();
+#endif //_WIN32
+}
+
+static int io_event_reactor_init(struct io_reactor *rt, int id, int size)
+{
+	int uring = 0;
+
+	rt->id = id;
+	rt->th = NULL;
+	rt->udp_msgs = NULL;
+	rt->read_buf = NULL;
+	rt->ready_head = NULL;
+	rt->ready_tail = NULL;
+	rt->ready_count = 0;
+	rt->free_head = NULL;
+	rt->free_wait = NULL;
+	rt->free_ready = 0;
+	rt->cmd_head = 0;
+
+	rt->tw = timer_wheel_create(timer_wheel_now());
+	if(NULL==rt->tw) {
+		LOG_WARN("[io_event] init reactor failed, create timer wheel failed.");
+		return -1;
+	}
+
+	//thread lock
+	rt->tlock = lock_create_critical_section();
+	if(NULL==rt->tlock) {
+		timer_wheel_destroy(rt->tw);
+		LOG_WARN("[io_event] init reactor failed, create thread lock failed.");
+		return -1;
+	}
+
+	//sockets are small numbers, the table grows if a larger one joins
+	for(rt->slot_count=64; rt->slot_count<(unsigned int)size; rt->slot_count<<=1);
+	rt->slots = (struct io_slot*)mem_pool_malloc(sizeof(struct io_slot)*rt->slot_count);
+	if(NULL==rt->slots) {
+		timer_wheel_destroy(rt->tw);
+		lock_destroy(rt->tlock);
+		LOG_WARN("[io_event] init reactor failed, create connection table failed.");
+		return -1;
+	}
+	memset(rt->slots, 0, sizeof(struct io_slot)*rt->slot_count);
+
+	rt->ie = NULL;
+	if(EIB_URING==g_backend) {
+		rt->ie = io_event_create_uring(size);
+		if(NULL==rt->ie) {
+			LOG_WARN("[io_event] init reactor, create io_uring event failed, fallback to epoll.");
+		}
+		uring = (NULL!=rt->ie) ? (1) : (0);
+	}
+	if(NULL==rt->ie) {
+		rt->ie = io_event_create(size);
+	}
+	if(NULL==rt->ie) {
+		timer_wheel_destroy(rt->tw);
+		mem_pool_free(rt->slots);
+		lock_destroy(rt->tlock);
+		LOG_WARN("[io_event] init reactor failed, event create failed.");
+		return -1;
+	}
+	//only the reactor thread runs the loop, so no EPOLLONESHOT re-arm is needed,
+	//edge trigger, every handle is read until EAGAIN or its read budget is used up,
+	//the latter is put in ready list and resumed by next loop.
+	//io_uring notifies every received data and accepted client by operations,
+	//the poll left for writable and error is oneshot and re-armed after every event
+	io_event_set_trigger(rt->ie, (uring) ? (EITM_LEVEL) : (EITM_EDGE));
+	io_event_set_hook(rt->ie, io_event_reactor_hook, rt);
+
+	return 0;
+}
+
+static void io_event_reactor_release(struct io_reactor *rt)
+{
+	unsigned int i;
+	struct timer_node *tn;
+	struct io_cmd *cmd, *next;
+
+	io_event_destroy(rt->ie);
+	rt->ie = NULL;
+	//the posted commands are dropped
+	for(cmd=(struct io_cmd*)rt->cmd_head; cmd; cmd=next) {
+		next = cmd->next;
+		if(EICT_RESUME==cmd->type) {
+			--((struct io_event_data*)cmd->arg)->refs;
+		}
+		free(cmd);
+	}
+	rt->cmd_head = 0;
+	for(i=0; i<rt->slot_count; ++i) {
+		if(rt->slots[i].ed) {
+			io_event_data_free(rt->slots[i].ed);
+		}
+	}
+	//the closed are waiting first, then released, the udp sessions
+	//of released server are closed by releasing
+	while(rt->free_head || rt->free_wait) {
+		io_event_free_closed(rt);
+	}
+	mem_pool_free(rt->slots);
+	rt->slots = NULL;
+	rt->slot_count = 0;
+	while(NULL != (tn = timer_wheel_pop(rt->tw))) {
+		mem_pool_free(tn);
+	}
+	timer_wheel_destroy(rt->tw);
+	rt->tw = NULL;
+	if(rt->udp_msgs) {
+		mem_pool_free(rt->udp_msgs[0].buf);
+		mem_pool_free(rt->udp_msgs);
+		rt->udp_msgs = NULL;
+	}
+	if(rt->read_buf) {
+		mem_pool_free(rt->read_buf);
+		rt->read_buf = NULL;
+	}
+	lock_destroy(rt->tlock);
+	rt->tlock = NULL;
+}
+
+static struct io_reactor* io_event_next_reactor()
+{
+	unsigned long idx = (unsigned long)atomic_add(&g_reactor_next, 1);
+	return &g_reactors[idx % g_reactor_count];
+}
+
+static int io_event_join_handle(struct io_reactor *rt, struct io_handle *hd)
+{
+	((struct io_event_data*)hd)->rt = rt;
+
+	//thread lock, only the owner reactor contend for it
+	LOCK(rt);
+	if(-1==io_event_join_locked(rt, hd)) {
+		UNLOCK(rt);
+		return -1;
+	}
+	UNLOCK(rt);
+
+	return 0;
+}
+
+static int io_event_join_locked(struct io_reactor *rt, struct io_handle *hd)
+{
+	unsigned int op;
+	struct io_event_data *ed = (struct io_event_data*)hd;
+
+	//listening socket accepts and tcp client receives by io_uring operations,
+	//recv is not armed until connected, so the connecting error is left to poll
+	op = (EST_TCP_SERVER==ed->type) ? (IO_OP_ACCEPT) : ((EST_TCP_CLIENT==ed->type) ? (IO_OP_RECV) : (0));
+	//add to io_event object
+	if(-1==io_event_add_ex(rt->ie, hd, op, io_event_interest(ed))) {
+		LOG_WARN("[io_event] join io_handle to io_event, add data to io_event failed.");
+		return -1;
+	}
+	//add mem pointer to connection table
+	if(-1==io_event_slot_add_locked(rt, (struct io_event_data*)hd)) {
+		io_event_del(rt->ie, hd);
+		LOG_WARN("[io_event] join io_handle to io_event, add data to connection table failed.");
+		return -1;
+	}
+
+	LOG_DEBUG("[io_event] join socket=%ld to io_event of reactor=%d ok.", (long)hd->s, rt->id);
+
+	return 0;
+}
+
+static int io_event_slot_add_locked(struct io_reactor *rt, struct io_event_data *ed)
+{
+	unsigned int count;
+	unsigned long idx = (unsigned long)ed->s;
+	struct io_slot *slots;
+
+	if(idx>=rt->slot_count) {
+		for(count=rt->slot_count; count<=idx; count<<=1);
+		slots = (struct io_slot*)mem_pool_malloc(sizeof(struct io_slot)*count);
+		if(NULL==slots) {
+			return -1;
+		}
+		memcpy(slots, rt->slots, sizeof(struct io_slot)*rt->slot_count);
+		memset(slots+rt->slot_count, 0, sizeof(struct io_slot)*(count-rt->slot_count));
+		mem_pool_free(rt->slots);
+		rt->slots = slots;
+		rt->slot_count = count;
+	}
+	if(rt->slots[idx].ed) {
+		//the socket is not closed by io_event_close_handle
+		return -1;
+	}
+	rt->slots[idx].ed = ed;
+	//new generation, the ids of former handles are invalid
+	if(0 == ++rt->slots[idx].gen) {
+		rt->slots[idx].gen = 1;
+	}
+
+	return 0;
+}
+
+static struct io_event_data* io_event_slot_del_locked(struct io_reactor *rt, SOCKET s)
+{
+	unsigned long idx = (unsigned long)s;
+	struct io_event_data *ed;
+
+	if(idx>=rt->slot_count || NULL==rt->slots[idx].ed) {
+		return NULL;
+	}
+	ed = rt->slots[idx].ed;
+	rt->slots[idx].ed = NULL;
+
+	return ed;
+}
+
+//find handle of id and keep it from releasing until io_event_unpin
+static struct io_event_data* io_event_pin(unsigned long long id)
+{
+	struct io_reactor *rt;
+	struct io_event_data *ed = NULL;
+	unsigned long idx = (unsigned long)(id & ((1UL<<IO_ID_SOCKET_BITS)-1));
+	unsigned int gen = (unsigned int)(id>>32);
+	int rid = (int)((id>>IO_ID_SOCKET_BITS) & (IO_ID_REACTOR_MAX-1));
+
+	if(NULL==g_reactors || 0==gen || rid>=g_reactor_count) {
+		return NULL;
+	}
+	rt = &g_reactors[rid];
+	LOCK(rt);
+	if(idx<rt->slot_count && rt->slots[idx].gen==gen && rt->slots[idx].ed && !rt->slots[idx].ed->closed) {
+		ed = rt->slots[idx].ed;
+		++ed->refs;
+	}
+	UNLOCK(rt);
+
+	return ed;
+}
+
+static void io_event_unpin(struct io_event_data *ed)
+{
+	int wakeup;
+	struct io_reactor *rt = ed->rt;
+
+	LOCK(rt);
+	wakeup = (0==--ed->refs && ed->closed);
+	UNLOCK(rt);
+	if(wakeup && t_reactor!=rt) {
+		//release it by reactor
+		io_event_wakeup(rt->ie);
+	}
+}
+
+//release closed handles that waited for one loop and are not pinned,
+//the handles closed after last calling wait for next calling,
+//called by reactor thread between loops
+static void io_event_free_closed(struct io_reactor *rt)
+{
+	struct io_event_data *ed, *next;
+	struct io_event_data *frees = NULL;
+	struct io_event_data *keeps;
+
+	LOCK(rt);
+	keeps = rt->free_head;
+	for(ed=rt->free_wait; ed; ed=next) {
+		next = ed->free_next;
+		if(ed->refs) {
+			ed->free_next = keeps;
+			keeps = ed;
+		} else {
+			ed->free_next = frees;
+			frees = ed;
+		}
+	}
+	rt->free_head = NULL;
+	rt->free_wait = keeps;
+	rt->free_ready = 0;
+	for(ed=keeps; ed; ed=ed->free_next) {
+		if(0==ed->refs) {
+			++rt->free_ready;
+		}
+	}
+	UNLOCK(rt);
+
+	for(ed=frees; ed; ed=next) {
+		next = ed->free_next;
+		if(EST_UDP_SESSION==ed->type) {
+			io_event_channel_opt_put(ed->opt);
+			mem_pool_free(ed);
+		} else {
+			io_event_forget(rt->ie, (struct io_handle*)ed);
+			io_event_data_free(ed);
+		}
+	}
+}
+
+//push command to the reactor of id, the reactor is woken only by the
+//first command after draining
+static int io_event_post_cmd(struct io_cmd *cmd)
+{
+	long head;
+	struct io_reactor *rt;
+	int rid = (int)((cmd->id>>IO_ID_SOCKET_BITS) & (IO_ID_REACTOR_MAX-1));
+
+	if(NULL==g_reactors || rid>=g_reactor_count) {
+		free(cmd);
+		LOG_WARN("[io_event] post command failed, reactor=%d is invalid.", rid);
+		return -1;
+	}
+	rt = &g_reactors[rid];
+	do {
+		head = rt->cmd_head;
+		cmd->next = (struct io_cmd*)head;
+	}while(head != atomic_compare_set(&rt->cmd_head, head, (long)cmd));
+	if(0==head && t_reactor!=rt) {
+		io_event_wakeup(rt->ie);
+	}
+
+	return 0;
+}
+
+//run commands posted to reactor in order, called by reactor thread
+static void io_event_run_cmds(struct io_reactor *rt)
+{
+	int cnt;
+	long head;
+	struct io_cmd *cmd, *next, *end;
+	struct io_cmd *cmds = NULL;
+
+	//take all, then reverse to posted order
+	do {
+		head = rt->cmd_head;
+	}while(head != atomic_compare_set(&rt->cmd_head, head, 0));
+	for(cmd=(struct io_cmd*)head; cmd; cmd=next) {
+		next = cmd->next;
+		cmd->next = cmds;
+		cmds = cmd;
+	}
+
+	while(NULL != (cmd = cmds)) {
+		if(EICT_SEND==cmd->type) {
+			//the sends of one handle in a row share one writev
+			cnt = 1;
+			for(end=cmd->next; end && cnt<NET_CMD_IOV_MAX && EICT_SEND==end->type && end->id==cmd->id; end=end->next) {
+				++cnt;
+			}
+			cmds = end;
+			io_event_send_cmds(cmd, cnt);
+			continue;
+		}
+		cmds = cmd->next;
+		if(EICT_CLOSE==cmd->type) {
+			if(-1==io_event_close_id(cmd->id)) {
+				LOG_DEBUG("[io_event] run posted close failed, id=%llu is closed.", cmd->id);
+			}
+		} else if(EICT_RESUME==cmd->type) {
+			io_event_read_resume((struct io_event_data*)cmd->arg, IO_PAUSE_WORKER);
+			io_event_unpin((struct io_event_data*)cmd->arg);
+		} else {
+			cmd->pf(cmd->arg);
+		}
+		free(cmd);
+	}
+}
+
+//send and free the first cnt send commands of one handle
+static void io_event_send_cmds(struct io_cmd *cmd, int cnt)
+{
+	int i, len = 0;
+	struct io_cmd *next;
+	struct io_event_data *ed = io_event_pin(cmd->id);
+	struct iovec iov[NET_CMD_IOV_MAX];
+
+	for(i=0, next=cmd; i<cnt; ++i, next=next->next) {
+		iov[i].iov_base = next->data;
+		iov[i].iov_len = next->len;
+		len += (int)next->len;
+	}
+	if(NULL==ed) {
+		LOG_DEBUG("[io_event] run posted send len=%d failed, id=%llu is closed.", len, cmd->id);
+	} else if(EST_TCP_CLIENT==ed->type) {
+		if(-1==io_event_send_datav((struct io_handle*)ed, iov, cnt)) {
+			LOG_DEBUG("[io_event] run posted send len=%d failed at socket=%ld.", len, (long)ed->s);
+		}
+		io_event_unpin(ed);
+	} else {
+		//one datagram every command
+		for(i=0; i<cnt; ++i) {
+			io_event_send_datav((struct io_handle*)ed, &iov[i], 1);
+		}
+		io_event_unpin(ed);
+	}
+
+	for(i=0; i<cnt; ++i) {
+		next = cmd->next;
+		free(cmd);
+		cmd = next;
+	}
+}
+
+//the handle has more data than read budget, no new edge for it
+static void io_event_ready_add(struct io_event_data *ed)
+{
+	struct io_reactor *rt = ed->rt;
+
+	LOCK(rt);
+	if(0==ed->ready && !ed->closed) {
+		ed->ready = 1;
+		ed->ready_prev = rt->ready_tail;
+		ed->ready_next = NULL;
+		if(rt->ready_tail) {
+			rt->ready_tail->ready_next = ed;
+		} else {
+			rt->ready_head = ed;
+		}
+		rt->ready_tail = ed;
+		++rt->ready_count;
+	}
+	UNLOCK(rt);
+}
+
+static void io_event_ready_del_locked(struct io_event_data *ed)
+{
+	struct io_reactor *rt = ed->rt;
+
+	if(0==ed->ready) {
+		return ;
+	}
+	if(ed->ready_prev) {
+		ed->ready_prev->ready_next = ed->ready_next;
+	} else {
+		rt->ready_head = ed->ready_next;
+	}
+	if(ed->ready_next) {
+		ed->ready_next->ready_prev = ed->ready_prev;
+	} else {
+		rt->ready_tail = ed->ready_prev;
+	}
+	ed->ready_prev = NULL;
+	ed->ready_next = NULL;
+	ed->ready = 0;
+	--rt->ready_count;
+}
+
+//the option got must be put back with io_event_channel_opt_put
+static const struct io_channel_opt* io_event_channel_opt_get(unsigned short channel)
+{
+	long val;
+	struct io_channel_ver *ver;
+	const struct io_channel_opt *opt = &g_default_opt;
+
+	if(g_channel_opts) {
+		lock_lock(g_opt_tlock);
+		if(0==hash_map_find(g_channel_opts, (long)channel, &val)) {
+			ver = ((struct io_channel_ver*)val)->last;
+			++ver->refs;
+			opt = &ver->opt;
+		}
+		lock_unlock(g_opt_tlock);
+	}
+
+	return opt;
+}
+
+static void io_event_channel_opt_put(const struct io_channel_opt *opt)
+{
+	struct io_channel_ver *ver = (struct io_channel_ver*)opt;
+
+	if(NULL==opt || &g_default_opt==opt) {
+		return;
+	}
+
+	lock_lock(g_opt_tlock);
+	//free the replaced version not referred, the first one is the head of g_channel_opts
+	if(0==--ver->refs && ver->prev && ver->next) {
+		ver->prev->next = ver->next;
+		ver->next->prev = ver->prev;
+	}
+	else {
+		ver = NULL;
+	}
+	lock_unlock(g_opt_tlock);
+	if(ver) {
+		mem_pool_free(ver);
+	}
+}
+
+static int io_event_send_tcpv(struct io_event_data *ed, const struct iovec *iov, int cnt, int len)
+{
+	int i = 0, k, m;
+	int sent, ret = len;
+	size_t off = 0, req;
+	int notify = 0, mod = 0, wakeup = 0;
+	unsigned int queued = 0;
+	struct io_buf_node *done = NULL;
+	struct io_reactor *rt = ed->rt;
+
+	LOCK(rt);
+	if(ed->closed) {
+		UNLOCK(rt);
+		return -1;
+	}
+	if(NULL==ed->out_head && io_event_out_own_locked(ed)) {
+		//nothing queued, send directly without lock, the data of other
+		//threads is queued meanwhile
+		UNLOCK(rt);
+		while(i<cnt) {
+			m = (cnt-i > NET_IOV_MAX) ? (NET_IOV_MAX) : (cnt-i);
+			sent = socket_send_tcpv(ed->s, iov+i, m);
+			if(sent<0) {
+				LOG_WARN("[io_event] send data failed at socket=%ld, errno=%d.", (long)ed->s, errno);
+				ret = -1;
+				break;
+			}
+			for(req=0, k=0; k<m; ++k) {
+				req += iov[i+k].iov_len;
+			}
+			if((size_t)sent==req) {
+				i += m;
+				continue;
+			}
+			//partial write, skip sent data across iovec boundaries
+			while((size_t)sent>=iov[i].iov_len) {
+				sent -= (int)iov[i].iov_len;
+				++i;
+			}
+			off = (size_t)sent;
+			break;
+		}
+		LOCK(rt);
+		if(-1!=ret && i<cnt) {
+			//the left is before the data queued meanwhile
+			if(-1==io_event_out_prepend(ed, iov+i, cnt-i, off)) {
+				LOG_WARN("[io_event] send data failed at socket=%ld, queue data failed.", (long)ed->s);
+				ret = -1;
+			}
+		} else if(-1!=ret && ed->out_head) {
+			//socket buffer is not full, send the data queued meanwhile
+			io_event_out_flush(ed);
+			done = io_event_zerocopy_reap(ed);
+		}
+		wakeup = io_event_out_release_locked(ed);
+	} else {
+		//queue the data, flushed by loop or the thread sending when socket is writable
+		for(; i<cnt; ++i) {
+			if(-1==io_event_out_append(ed, (const char*)iov[i].iov_base, (unsigned int)iov[i].iov_len)) {
+				LOG_WARN("[io_event] send data failed at socket=%ld, queue data failed.", (long)ed->s);
+				ret = -1;
+				break;
+			}
+		}
+	}
+	if(ed->out_head) {
+		notify = io_event_out_queued(ed, &queued);
+	}
+	mod = io_event_interest_begin_locked(ed);
+	UNLOCK(rt);
+
+	if(mod) {
+		io_event_interest_apply(ed);
+	}
+	if(wakeup) {
+		io_event_wakeup(rt->ie);
+	}
+	if(notify) {
+		io_event_notify_simple(ed, ENT_SEND_HIGH, (int)queued);
+	}
+	io_event_zerocopy_notify(ed, done);
+
+	return ret;
+}
+
+//queue the left of direct sending before the data queued meanwhile, called with rt->tlock
+static int io_event_out_prepend(struct io_event_data *ed, const struct iovec *iov, int cnt, size_t off)
+{
+	int i, ret = 0;
+	struct io_buf_node *head = ed->out_head;
+	struct io_buf_node *tail = ed->out_tail;
+
+	ed->out_head = ed->out_tail = NULL;
+	for(i=0; i<cnt && 0==ret; ++i, off=0) {
+		ret = io_event_out_append(ed, (const char*)iov[i].iov_base+off, (unsigned int)(iov[i].iov_len-off));
+	}
+	if(head) {
+		if(ed->out_tail) {
+			ed->out_tail->next = head;
+		} else {
+			ed->out_head = head;
+		}
+		ed->out_tail = tail;
+	}
+
+	return ret;
+}
+
+//check high watermark of queued data, called with rt->tlock
+//return: 1 notify ENT_SEND_HIGH, 0 not
+static int io_event_out_queued(struct io_event_data *ed, unsigned int *queued)
+{
+	if(!ed->out_high && ed->out_len>=ed->opt->send_high_watermark) {
+		ed->out_high = 1;
+		*queued = ed->out_len;
+		return 1;
+	}
+	return 0;
+}
+
+//take the writing of socket, it is pinned until released, called with rt->tlock
+//return: 1 owned, 0 written by other thread or closed
+static int io_event_out_own_locked(struct io_event_data *ed)
+{
+	if(ed->sending || ed->closed) {
+		return 0;
+	}
+	ed->sending = 1;
+	++ed->refs;
+	return 1;
+}
+
+//called with rt->tlock
+//return: 1 wake up reactor to release the closed handle, 0 not
+static int io_event_out_release_locked(struct io_event_data *ed)
+{
+	ed->sending = 0;
+	return (0==--ed->refs && ed->closed && t_reactor!=ed->rt);
+}
+
+//take the changing of monitored events, it is pinned until applied, called with rt->tlock
+//return: 1 call io_event_interest_apply after unlocking, 0 not changed or changed by other thread
+static int io_event_interest_begin_locked(struct io_event_data *ed)
+{
+	if(ed->closed) {
+		return 0;
+	}
+	if(ed->modding) {
+		//applied by the thread modding again
+		ed->mod_again = 1;
+		return 0;
+	}
+	if(io_event_interest(ed)==(ed->events&(IO_EVENT_READ|IO_EVENT_WRITE))) {
+		return 0;
+	}
+	ed->modding = 1;
+	++ed->refs;
+	return 1;
+}
+
+//epoll_ctl or submitting of io_uring is done without lock, the interest is
+//read again until not changed by other threads
+static void io_event_interest_apply(struct io_event_data *ed)
+{
+	int wakeup;
+	unsigned int events;
+	struct io_reactor *rt = ed->rt;
+
+	LOCK(rt);
+	do {
+		ed->mod_again = 0;
+		if(ed->closed) {
+			break;
+		}
+		events = io_event_interest(ed);
+		UNLOCK(rt);
+		io_event_mod(rt->ie, (struct io_handle*)ed, events);
+		LOCK(rt);
+	}while(ed->mod_again);
+	ed->modding = 0;
+	wakeup = (0==--ed->refs && ed->closed);
+	UNLOCK(rt);
+
+	if(wakeup && t_reactor!=rt) {
+		io_event_wakeup(rt->ie);
+	}
+}
+
+static int io_event_send_zerocopy(struct io_event_data *ed, const char *data, int len)
+{
+	int ret = 0;
+	int notify = 0, mod = 0, wakeup = 0;
+	unsigned int queued = 0;
+	struct io_buf_node *bn, *done;
+	struct io_reactor *rt = ed->rt;
+
+	//refer to the data instead of copying
+	bn = (struct io_buf_node*)mem_pool_malloc(sizeof(struct io_buf_node));
+	if(NULL==bn) {
+		LOG_WARN("[io_event] send data failed at socket=%ld, malloc failed.", (long)ed->s);
+		return -1;
+	}
+	memset(bn, 0, sizeof(struct io_buf_node));
+	bn->ext = data;
+	bn->size = (unsigned int)len;
+	bn->len = (unsigned int)len;
+
+	LOCK(rt);
+	if(ed->closed) {
+		UNLOCK(rt);
+		mem_pool_free(bn);
+		return -1;
+	}
+	if(ed->out_tail) {
+		ed->out_tail->next = bn;
+	} else {
+		ed->out_head = bn;
+	}
+	ed->out_tail = bn;
+	ed->out_len += bn->len;
+
+	if(bn==ed->out_head && io_event_out_own_locked(ed)) {
+		//nothing queued before, send directly
+		ret = io_event_out_flush(ed);
+		if(-1==ret && bn==ed->out_head && 0==bn->off && 0==bn->zc_count) {
+			//not sent, the data queued meanwhile is flushed by loop
+			ed->out_head = bn->next;
+			if(NULL==ed->out_head) {
+				ed->out_tail = NULL;
+			}
+			ed->out_len -= bn->len;
+			mem_pool_free(bn);
+		} else {
+			ret = 0;
+		}
+		wakeup = io_event_out_release_locked(ed);
+	}
+	if(ed->out_head) {
+		notify = io_event_out_queued(ed, &queued);
+	}
+	done = io_event_zerocopy_reap(ed);
+	mod = io_event_interest_begin_locked(ed);
+	UNLOCK(rt);
+
+	if(-1==ret) {
+		LOG_WARN("[io_event] send data failed at socket=%ld, errno=%d.", (long)ed->s, errno);
+	}
+	if(mod) {
+		io_event_interest_apply(ed);
+	}
+	if(wakeup) {
+		io_event_wakeup(rt->ie);
+	}
+	if(notify) {
+		io_event_notify_simple(ed, ENT_SEND_HIGH, (int)queued);
+	}
+	io_event_zerocopy_notify(ed, done);
+
+	return (-1==ret) ? (-1) : (len);
+}
+
+//count of completed numbers from lo to hi in the numbers of node, the numbers wrap around
+static inline unsigned int io_event_zerocopy_overlap(const struct io_buf_node *bn, unsigned int lo, unsigned int hi)
+{
+	unsigned int n = hi - lo + 1;
+	unsigned int d = lo - bn->zc_id;
+
+	if(d < bn->zc_count) {
+		//starts in node
+		return (n < bn->zc_count-d) ? (n) : (bn->zc_count-d);
+	}
+	d = bn->zc_id - lo;
+	if(d < n) {
+		//starts before node
+		return (n-d < bn->zc_count) ? (n-d) : (bn->zc_count);
+	}
+	return 0;
+}
+
+//read completions from socket error queue, called with rt->tlock
+static void io_event_zerocopy_complete(struct io_event_data *ed)
+{
+	int ret, copied;
+	unsigned int lo, hi;
+	struct io_buf_node *bn;
+
+	while(0 < (ret = socket_recv_zerocopy(ed->s, &lo, &hi, &copied))) {
+		if(1!=ret) {
+			//not a completion
+			continue;
+		}
+		if(copied && !ed->zc_copied) {
+			//zerocopy is slower than copy if the kernel copies, the later
+			//data is copied and ENT_SEND_DONE is notified after sending
+			LOG_DEBUG("[io_event] socket=%ld zerocopy send is copied, copy it instead.", (long)ed->s);
+			ed->zc_copied = 1;
+		}
+		//the head of queue may be sent partly
+		bn = (ed->out_head && ed->out_head->zc_count) ? ed->out_head : ed->zc_head;
+		while(bn) {
+			if(bn->zc_count) {
+				bn->zc_done += io_event_zerocopy_overlap(bn, lo, hi);
+			}
+			bn = (bn==ed->out_head) ? ed->zc_head : bn->next;
+		}
+	}
+}
+
+//detach sent and completed nodes, called with rt->tlock
+static struct io_buf_node* io_event_zerocopy_reap(struct io_event_data *ed)
+{
+	struct io_buf_node *bn, *prev = NULL, *next;
+	struct io_buf_node *done = NULL, *done_tail = NULL;
+
+	for(bn=ed->zc_head; bn; bn=next) {
+		next = bn->next;
+		if(bn->zc_done<bn->zc_count) {
+			prev = bn;
+			continue;
+		}
+		if(prev) {
+			prev->next = next;
+		} else {
+			ed->zc_head = next;
+		}
+		if(bn==ed->zc_tail) {
+			ed->zc_tail = prev;
+		}
+		bn->next = NULL;
+		if(done_tail) {
+			done_tail->next = bn;
+		} else {
+			done = bn;
+		}
+		done_tail = bn;
+	}
+
+	return done;
+}
+
+//notify ENT_SEND_DONE and free nodes, called without rt->tlock
+static void io_event_zerocopy_notify(struct io_event_data *ed, struct io_buf_node *done)
+{
+	struct io_buf_node *bn;
+	struct event_notify_data nd;
+
+	while(NULL != (bn = done)) {
+		done = bn->next;
+		nd.type = ENT_SEND_DONE;
+		nd.data = (char*)bn->ext;
+		nd.addr = NULL;
+		nd.len = (int)bn->len;
+		g_nt_func((struct io_handle*)ed, ed->channel, &nd);
+		mem_pool_free(bn);
+	}
+}
+
+static int io_event_out_append(struct io_event_data *ed, const char *data, unsigned int len)
+{
+	unsigned int n, size;
+	struct io_buf_node *bn;
+
+	while(len>0) {
+		bn = ed->out_tail;
+		if(NULL==bn || bn->len==bn->size) {
+			size = (len > NET_OUT_NODE_SIZE-sizeof(struct io_buf_node)) ? (len) : (NET_OUT_NODE_SIZE-sizeof(struct io_buf_node));
+			bn = (struct io_buf_node*)mem_pool_malloc(sizeof(struct io_buf_node)+size);
+			if(NULL==bn) {
+				return -1;
+			}
+			memset(bn, 0, sizeof(struct io_buf_node));
+			bn->size = size;
+			if(ed->out_tail) {
+				ed->out_tail->next = bn;
+			} else {
+				ed->out_head = bn;
+			}
+			ed->out_tail = bn;
+		}
+		n = (len > bn->size-bn->len) ? (bn->size-bn->len) : (len);
+		memcpy((char*)IO_BUF_NODE_DATA(bn)+bn->len, data, n);
+		bn->len += n;
+		ed->out_len += n;
+		data += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+//write queued data without lock, called by the owner of sending with rt->tlock
+//return: -1 error, 0 ok(all sent or socket buffer is full)
+static int io_event_out_flush(struct io_event_data *ed)
+{
+	int sent, zc, copied;
+	unsigned int len;
+	const char *data;
+	struct io_buf_node *bn;
+	struct io_reactor *rt = ed->rt;
+
+	while(NULL != (bn = ed->out_head)) {
+		//the data appended meanwhile is after len, the part in sending is not changed
+		len = bn->len - bn->off;
+		data = (bn->ext) ? (bn->ext+bn->off) : (IO_BUF_NODE_DATA(bn)+bn->off);
+		zc = (bn->ext && !ed->zc_copied);
+		copied = 0;
+		if(zc) {
+			//every successful call takes a completion number, which is taken
+			//before sending since the completion may be read before return
+			if(0==bn->zc_count) {
+				bn->zc_id = ed->zc_next;
+			}
+			++bn->zc_count;
+			++ed->zc_next;
+		}
+		UNLOCK(rt);
+		if(zc) {
+			sent = socket_send_tcp_zerocopy(ed->s, data, (int)len);
+			if(sent<0 && ENOBUFS==errno) {
+				//too many completions not read, copy this time
+				copied = 1;
+				sent = socket_send_tcp(ed->s, data, (int)len);
+			}
+		} else {
+			sent = socket_send_tcp(ed->s, data, (int)len);
+		}
+		LOCK(rt);
+		if(zc && (sent<=0 || copied)) {
+			//no completion number is taken
+			--bn->zc_count;
+			--ed->zc_next;
+		}
+		if(sent<0) {
+			return -1;
+		}
+		bn->off += sent;
+		ed->out_len -= sent;
+		if((unsigned int)sent<len) {
+			//socket buffer is full
+			break;
+		}
+		if(bn->off<bn->len) {
+			//appended meanwhile
+			continue;
+		}
+		ed->out_head = bn->next;
+		if(NULL==ed->out_head) {
+			ed->out_tail = NULL;
+		}
+		if(bn->ext) {
+			//wait for completion, the user data is still used by kernel
+			bn->next = NULL;
+			if(ed->zc_tail) {
+				ed->zc_tail->next = bn;
+			} else {
+				ed->zc_head = bn;
+			}
+			ed->zc_tail = bn;
+		} else {
+			mem_pool_free(bn);
+		}
+	}
+
+	return 0;
+}
+
+static void io_event_out_free(struct io_event_data *ed)
+{
+	struct io_buf_node *bn;
+
+	while(NULL != (bn = ed->out_head)) {
+		ed->out_head = bn->next;
+		mem_pool_free(bn);
+	}
+	ed->out_tail = NULL;
+	ed->out_len = 0;
+	while(NULL != (bn = ed->zc_head)) {
+		ed->zc_head = bn->next;
+		mem_pool_free(bn);
+	}
+	ed->zc_tail = NULL;
+}
+
+static int io_event_reactor_hook(struct io_event *ie, void *arg)
+{
+	int timeout;
+	unsigned int cnt;
+	struct io_reactor *rt = (struct io_reactor*)arg;
+	struct io_timer *timer;
+	struct io_event_data *ed;
+	unsigned long long now;
+
+	//the handles closed before last loop are not referred by the loop now
+	if(rt->free_head || rt->free_wait) {
+		io_event_free_closed(rt);
+	}
+
+	//commands posted by other threads
+	if(rt->cmd_head) {
+		io_event_run_cmds(rt);
+	}
+
+	//resume handles that used up read budget in last loop, the handles
+	//put back by themselves wait for next loop
+	LOCK(rt);
+	for(cnt=rt->ready_count; cnt>0 && NULL!=(ed = rt->ready_head); --cnt) {
+		io_event_ready_del_locked(ed);
+		UNLOCK(rt);
+		io_event_notify_handle(ie, (struct io_handle*)ed, IO_EVENT_READ);
+		LOCK(rt);
+	}
+
+	now = timer_wheel_now();
+	while(NULL != (timer = (struct io_timer*)timer_wheel_expire(rt->tw, now))) {
+		timer->firing = 1;
+		UNLOCK(rt);
+		timer->pf(timer, timer->arg);
+		LOCK(rt);
+		timer->firing = 0;
+		if(timer->cancelled) {
+			mem_pool_free(timer);
+		} else if(timer->interval && !timer_wheel_pending(&timer->node)) {
+			//periodic timer, not rearmed by pf
+			timer_wheel_add(rt->tw, &timer->node, 
+					(timer->node.expire+timer->interval > now) ? (timer->node.expire+timer->interval) : (now+timer->interval));
+		}
+	}
+	//wait until the next timer, poll only if ready list is not empty
+	//or unpinned closed handles are waiting for releasing, or commands are posted by the loop,
+	//the pinned wait for the wakeup of io_event_unpin
+	timeout = (rt->ready_head || rt->free_head || rt->free_ready || rt->cmd_head) ? (0) : timer_wheel_next_timeout(rt->tw, now);
+	UNLOCK(rt);
+
+	return timeout;
+}
+
+static void io_event_idle_check(struct io_timer *timer, void *arg)
+{
+	unsigned long long idle;
+	struct io_event_data *ed = (struct io_event_data*)arg;
+	struct event_notify_data nd;
+
+	idle = timer_wheel_now() - ed->active_time;
+	if(idle < ed->idle_timeout) {
+		io_event_timer_rearm(timer, (unsigned int)(ed->idle_timeout - idle));
+		return ;
+	}
+
+	LOG_DEBUG("[io_event] socket=%ld idle for %llu ms, close it.", (long)ed->s, idle);
+	nd.type = ENT_CLOSE;
+	nd.data = NULL;
+	nd.addr = NULL;
+	nd.len = 0;
+	io_event_dispatch(ed, &nd);
+	io_event_close_handle((struct io_handle*)ed);
+}
+
+//result of io_event_connect_async, called once by the first event or timeout
+static void io_event_connect_done(struct io_event_data *ed, int err)
+{
+	int mod = 0;
+	struct io_reactor *rt = ed->rt;
+
+	LOCK(rt);
+	if(!ed->connecting || ed->closed) {
+		UNLOCK(rt);
+		return ;
+	}
+	ed->connecting = 0;
+	if(ed->conn_timer) {
+		io_event_timer_cancel_locked(ed->conn_timer);
+		ed->conn_timer = NULL;
+	}
+	if(0==err) {
+		mod = io_event_interest_begin_locked(ed);
+	}
+	UNLOCK(rt);
+
+	if(mod) {
+		io_event_interest_apply(ed);
+	}
+
+	if(err<0) {
+		err = errno;
+	}
+	if(err) {
+		LOG_WARN("[io_event] connect async failed at socket=%ld, errno=%d.", (long)ed->s, err);
+	}
+	io_event_notify_simple(ed, ENT_CONNECT, err);
+	if(err) {
+		io_event_close_handle((struct io_handle*)ed);
+	}
+}
+
+static void io_event_connect_timeout(struct io_timer *timer, void *arg)
+{
+	//use variable only for compiler
+	(void)timer;
+	io_event_connect_done((struct io_event_data*)arg, ETIMEDOUT);
+}
+
+//start connecting, the connection of pool is pinned and linked before joining,
+//so the events of warming one are handled by pool, its state is counted by caller
+static struct io_event_data* io_event_connect_handle(const char *ip, unsigned short port, unsigned short channel, unsigned int timeout, struct io_pool *pool, int state)
+{
+	int pending = 0, mod;
+	SOCKET s;
+	struct io_reactor *rt;
+	struct io_event_data *ed;
+	const struct io_channel_opt *opt;
+
+	opt = io_event_channel_opt_get(channel);
+	s = socket_connect_nonblock(ip, port, opt->connect_fastopen, &pending);
+	io_event_channel_opt_put(opt);
+	if(INVALID_SOCKET==s) {
+		LOG_WARN("[io_event] connect async failed, connect socket failed.");
+		return NULL;
+	}
+
+	ed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data));
+	if(NULL==ed) {
+		socket_close(s);
+		LOG_WARN("[io_event] connect async failed, mem_pool_malloc failed.");
+		return NULL;
+	}
+	io_event_data_init(ed, s, EST_TCP_CLIENT, channel);
+	ed->pool = pool;
+	ed->pool_state = state;
+	if(pool) {
+		//pinned by pool, or by user until io_event_pool_put if got, a got one
+		//closed by peer waits in free_wait without polling of its reactor
+		ed->refs = 1;
+		lock_lock(g_pool_tlock);
+		ed->pool_next = pool->head;
+		pool->head = ed;
+		lock_unlock(g_pool_tlock);
+	}
+	//ENT_CONNECT is notified by the first writable event even connected at once,
+	//the timer is added with the handle so the loop never sees one without other
+	ed->connecting = 1;
+	rt = io_event_next_reactor();
+	ed->rt = rt;
+	LOCK(rt);
+	if(-1==io_event_join_locked(rt, (struct io_handle*)ed)) {
+		UNLOCK(rt);
+		if(pool) {
+			//unlink only, the count is rolled back by caller
+			lock_lock(g_pool_tlock);
+			ed->pool_state = IO_POOL_DROPPED;
+			io_event_pool_move_locked(pool, ed, IO_POOL_DROPPED);
+			lock_unlock(g_pool_tlock);
+		}
+		socket_close(s);
+		io_event_channel_opt_put(ed->opt);
+		mem_pool_free(ed);
+		LOG_WARN("[io_event] connect async failed, join handle to io_event failed.");
+		return NULL;
+	}
+	mod = io_event_interest_begin_locked(ed);
+	if(pending && timeout>0) {
+		ed->conn_timer = io_event_timer_add_locked(rt, timeout, 0, io_event_connect_timeout, ed);
+	}
+	UNLOCK(rt);
+
+	if(mod) {
+		io_event_interest_apply(ed);
+	}
+
+	if(t_reactor!=rt) {
+		io_event_wakeup(rt->ie);
+	}
+
+	return ed;
+}
+
+static void thread_run(void *arg)
+{
+	struct io_reactor *rt = (struct io_reactor*)arg;
+	t_reactor = rt;
+	io_event_loop(rt->ie, io_event_notify_handle);
+	t_reactor = NULL;
+}
+
+static void io_event_notify_handle(struct io_event *ie, const struct io_handle *handle, unsigned int events)
+{
+	struct io_event_data *ed = (struct io_event_data*)handle;
+	struct io_buf_node *done;
+
+	if(ed->closed) {
+		//closed by former handle in this loop
+		return ;
+	}
+	if(ed->connecting) {
+		//any event completes the connecting, go on with the events if connected
+		io_event_connect_done(ed, socket_get_error(ed->s));
+		if(ed->closed) {
+			return ;
+		}
+	}
+	if(events&IO_EVENT_ERROR && ed->zc_next) {
+		//zerocopy completions in error queue
+		LOCK(ed->rt);
+		io_event_zerocopy_complete(ed);
+		done = io_event_zerocopy_reap(ed);
+		UNLOCK(ed->rt);
+		io_event_zerocopy_notify(ed, done);
+	}
+	if(events&IO_EVENT_WRITE) {
+		//flush outbound queue
+		io_event_write_tcp(ed, g_nt_func);
+	}
+	if(0==(events&IO_EVENT_READ)) {
+		return ;
+	}
+
+	switch(ed->type) {
+		case EST_TCP_SERVER://accept
+			LOG_DEBUG("[io_event] have event on socket=%ld, type=TCP-S.", (long)ed->s);
+			io_event_accept_client(ie, ed);
+			break;
+		case EST_UDP_SERVER://read
+			LOG_DEBUG("[io_event] have event on socket=%ld, type=UDP-S.", (long)ed->s);
+			io_event_read_udp(ie, ed, g_nt_func);
+			break;
+		case EST_TCP_CLIENT://read
+			LOG_DEBUG("[io_event] have event on socket=%ld, type=TCP-C.", (long)ed->s);
+			io_event_read_tcp(ie, ed);
+			break;
+		case EST_UDP_CLIENT://read
+			LOG_DEBUG("[io_event] have event on socket=%ld, type=UDP-C.", (long)ed->s);
+			io_event_read_udp(ie, ed, g_nt_func);
+			break;
+		default:
+		//case EST_UNKNOWN:
+			LOG_WARN("[io_event] handle event failed, socket=%ld type is unknow", (long)ed->s);
+			break;
+	}
+}
+
+static void io_event_notify_simple(struct io_event_data *ed, enum EEV_NOTIFY_TYPE type, int len)
+{
+	struct event_notify_data nd;
+
+	nd.type = type;
+	nd.data = NULL;
+	nd.addr = NULL;
+	nd.len = len;
+	io_event_dispatch(ed, &nd);
+}
+
+static void io_event_write_tcp(struct io_event_data *ed, pfunc_event_notify pf)
+{
+	int ret;
+	int notify = 0, mod = 0, wakeup = 0;
+	unsigned int queued = 0;
+	struct io_reactor *rt = ed->rt;
+	struct io_buf_node *bn, *done;
+	struct event_notify_data nd;
+
+	LOCK(rt);
+	if(!io_event_out_own_locked(ed)) {
+		//the thread sending flushes the queue, writable is monitored again after it
+		mod = io_event_interest_begin_locked(ed);
+		UNLOCK(rt);
+		if(mod) {
+			io_event_interest_apply(ed);
+		}
+		return ;
+	}
+	ret = io_event_out_flush(ed);
+	if(-1==ret) {
+		//the error is handled by reading, the zerocopy data is not used any more
+		while(NULL != (bn = ed->out_head)) {
+			ed->out_head = bn->next;
+			if(bn->ext) {
+				bn->zc_done = bn->zc_count;
+				bn->next = ed->zc_head;
+				ed->zc_head = bn;
+				if(NULL==ed->zc_tail) {
+					ed->zc_tail = bn;
+				}
+			} else {
+				mem_pool_free(bn);
+			}
+		}
+		ed->out_tail = NULL;
+		ed->out_len = 0;
+	}
+	done = io_event_zerocopy_reap(ed);
+	wakeup = io_event_out_release_locked(ed);
+	mod = io_event_interest_begin_locked(ed);
+	if(ed->out_high && ed->out_len<=ed->opt->send_low_watermark) {
+		ed->out_high = 0;
+		notify = 1;
+		queued = ed->out_len;
+	}
+	UNLOCK(rt);
+
+	if(mod) {
+		io_event_interest_apply(ed);
+	}
+	if(wakeup) {
+		io_event_wakeup(rt->ie);
+	}
+	if(-1==ret) {
+		LOG_WARN("[io_event] flush queued data failed at socket=%ld, errno=%d.", (long)ed->s, errno);
+	}
+	io_event_zerocopy_notify(ed, done);
+	if(notify) {
+		nd.type = ENT_SEND_LOW;
+		nd.data = NULL;
+		nd.addr = NULL;
+		nd.len = (int)queued;
+		pf((struct io_handle*)ed, ed->channel, &nd);
+	}
+}
+
+static void io_event_accept_client(struct io_event *ie, struct io_event_data *ed)
+{
+	int i, n, ret;
+	int cnt = 0, failed = 0;
+	SOCKET c;
+	struct io_reactor *rt;
+	struct io_event_data *newed;
+	struct io_event_data *neweds[NET_ACCEPT_BUDGET];
+	struct io_event_data *faileds[NET_ACCEPT_BUDGET];
+	char joined[NET_ACCEPT_BUDGET];
+	struct sockaddr_in addrs[NET_ACCEPT_BUDGET];
+	struct event_notify_data nd;
+
+	//drain accept queue, the left is resumed by next loop
+	while(cnt<NET_ACCEPT_BUDGET) {
+		ret = io_event_accept(ie, (struct io_handle*)ed, &c, &addrs[cnt]);
+		if(-3==ret) {
+			continue;
+		}
+		if(-2==ret) {
+			break;
+		}
+		if(-1==ret) {
+			//such as EMFILE, the backlog is not notified again by edge trigger
+			LOG_WARN("[io_event] handle event and accept new client failed at listening socket=%d, errno=%d.", ed->s, errno);
+			rt = ed->rt;
+			LOCK(rt);
+			if(ed->accept_timer) {
+				if(!timer_wheel_pending(&ed->accept_timer->node)) {
+					io_event_timer_rearm_locked(ed->accept_timer, NET_ACCEPT_RETRY);
+				}
+			} else if(!ed->closed) {
+				ed->accept_timer = io_event_timer_add_locked(rt, NET_ACCEPT_RETRY, 0, io_event_accept_retry, ed);
+			}
+			UNLOCK(rt);
+			break;
+		}
+		LOG_DEBUG("[io_event] handle event and accept new tcp client=%d [%s:%d] successfully", 
+				c, socket_convert_val2ip(addrs[cnt].sin_addr.s_addr), addrs[cnt].sin_port);
+
+		newed = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data));
+		if(NULL==newed) {
+			socket_close(c);
+			LOG_WARN("[io_event] handle event and accept new client failed at listening socket=%d, create io_handle failed.", ed->s);
+			continue;
+		}
+		io_event_data_init(newed, c, EST_TCP_CLIENT, ed->channel);
+		//the connections are spread over all reactors
+		newed->rt = io_event_next_reactor();
+		//pinned until notified, it may be closed by callback
+		newed->refs = 1;
+		//joined before notifying so the callback can send on it, another
+		//reactor may handle it at once, so reading waits for ENT_ACCEPT
+		newed->read_paused = IO_PAUSE_ACCEPT;
+		joined[cnt] = 0;
+		neweds[cnt++] = newed;
+	}
+	if(cnt==NET_ACCEPT_BUDGET) {
+		io_event_ready_add(ed);
+	}
+
+	//add to io monitor by batch, lock every reactor once
+	for(i=0; i<cnt; ++i) {
+		if(NULL==neweds[i] || joined[i]) {
+			continue;
+		}
+		rt = neweds[i]->rt;
+		LOCK(rt);
+		for(n=i; n<cnt; ++n) {
+			if(NULL==neweds[n] || joined[n] || neweds[n]->rt!=rt) {
+				continue;
+			}
+			if(-1==io_event_join_locked(rt, (struct io_handle*)neweds[n])) {
+				//not notified, released after unlock
+				faileds[failed++] = neweds[n];
+				neweds[n] = NULL;
+			} else {
+				joined[n] = 1;
+			}
+		}
+		UNLOCK(rt);
+	}
+	for(i=0; i<failed; ++i) {
+		LOG_WARN("[io_event] handle event and accept new client failed at listening socket=%d, join handle to io_event failed.", ed->s);
+		io_event_data_free(faileds[i]);
+	}
+
+	for(i=0; i<cnt; ++i) {
+		newed = neweds[i];
+		if(NULL==newed) {
+			continue;
+		}
+		nd.type = ENT_ACCEPT;
+		nd.data = NULL;
+		nd.addr = (const struct sockaddr*)&addrs[i];
+		nd.len = 0;
+		io_event_dispatch(newed, &nd);
+		//the readable edge may be consumed while waiting for ENT_ACCEPT, read it by reactor
+		io_event_read_resume(newed, IO_PAUSE_ACCEPT);
+		io_event_ready_add(newed);
+		if(t_reactor!=newed->rt) {
+			io_event_wakeup(newed->rt->ie);
+		}
+		io_event_unpin(newed);
+	}
+}
+
+static void io_event_accept_retry(struct io_timer *timer, void *arg)
+{
+	//use variable only for compiler
+	(void)timer;
+	//accepted by the ready list of reactor
+	io_event_ready_add((struct io_event_data*)arg);
+}
+
+static void io_event_read_udp(struct io_event *ie, struct io_event_data *ed, pfunc_event_notify pf)
+{
+	int i, cnt, round, off, seg;
+	struct udp_msg *msgs;
+	struct io_event_data *hd;
+	struct event_notify_data nd;
+
+	//use variable only for compiler
+	(void)ie;
+
+	msgs = io_event_udp_msgs(ed->rt);
+	if(NULL==msgs) {
+		LOG_WARN("[io_event] handle event and malloc udp buffer failed at socket=%ld.", (long)ed->s);
+		return ;
+	}
+
+	//drain socket by batches, the left is resumed by next loop
+	for(round=0; round<NET_UDP_ROUND_MAX; ++round) {
+		cnt = socket_recv_udp_batch(ed->s, msgs, NET_UDP_BATCH);
+		if(cnt<0 && EST_UDP_CLIENT==ed->type && ECONNREFUSED==errno) {
+			//ICMP port unreachable of connected socket, the peer is gone
+			LOG_WARN("[io_event] handle event and read udp client=%d data failed, errno=%d.", ed->s, errno);
+			nd.type = ENT_CLOSE;
+			nd.data = NULL;
+			nd.addr = NULL;
+			nd.len = 0;
+			pf((struct io_handle*)ed, ed->channel, &nd);
+			io_event_close_handle((struct io_handle*)ed);
+			return ;
+		}
+		if(cnt<0) {
+			//the queued ICMP error of one peer is cleared by reading, the sessions
+			//share the server socket, transient error such as ENOMEM is retried
+			//by next loop
+			LOG_WARN("[io_event] handle event and read udp socket=%ld data failed, errno=%d.", (long)ed->s, errno);
+			if(ECONNREFUSED==errno || EHOSTUNREACH==errno || ENETUNREACH==errno) {
+				continue;
+			}
+			break;
+		}
+		if(cnt>0) {
+			io_event_data_active(ed);
+		}
+		for(i=0; i<cnt; ++i) {
+			LOG_DEBUG("[io_event] recv datagram len=%d from socket=%ld, type=UDP.", msgs[i].len, (long)ed->s);
+			if(msgs[i].trunc) {
+				LOG_WARN("[io_event] udp datagram is larger than %d at socket=%ld, truncated.", msgs[i].size, (long)ed->s);
+			}
+			//the session of peer receives the datagrams
+			hd = ed;
+			if(ed->sessions && NULL==(hd = io_event_udp_session(ed, &msgs[i].addr, pf))) {
+				continue;
+			}
+			if(ed->closed) {
+				//closed by callback
+				return ;
+			}
+			//notify outside one by one, datagram boundary is kept,
+			//coalesced datagrams of udp gro are split in place
+			seg = (msgs[i].seg>0) ? (msgs[i].seg) : (msgs[i].len);
+			off = 0;
+			do {
+				nd.type = ENT_DATA;
+				nd.data = msgs[i].buf+off;
+				nd.addr = (const struct sockaddr*)&msgs[i].addr;
+				nd.len = (msgs[i].len-off > seg) ? (seg) : (msgs[i].len-off);
+				off += nd.len;
+				pf((struct io_handle*)hd, hd->channel, &nd);
+			}while(off<msgs[i].len && !hd->closed);
+			if(ed->closed) {
+				return ;
+			}
+		}
+		if(cnt<NET_UDP_BATCH) {
+			return ;
+		}
+	}
+	io_event_ready_add(ed);
+}
+
+//find or create session of udp peer, ENT_ACCEPT is notified for new session
+static struct io_event_data* io_event_udp_session(struct io_event_data *ed, const struct sockaddr_in *addr, pfunc_event_notify pf)
+{
+	long val;
+	struct io_event_data *sd;
+	struct event_notify_data nd;
+
+	LOCK(ed->rt);
+	if(0==hash_map_find(ed->sessions, (long)addr, &val)) {
+		UNLOCK(ed->rt);
+		sd = (struct io_event_data*)val;
+		io_event_data_active(sd);
+		return sd;
+	}
+	sd = (struct io_event_data*)mem_pool_malloc(sizeof(struct io_event_data)+sizeof(struct sockaddr_in));
+	if(NULL==sd) {
+		UNLOCK(ed->rt);
+		LOG_WARN("[io_event] create udp session failed at socket=%ld, malloc failed.", (long)ed->s);
+		return NULL;
+	}
+	io_event_data_init(sd, ed->s, EST_UDP_SESSION, ed->channel);
+	sd->rt = ed->rt;
+	sd->server = ed;
+	memcpy(IODT_PEER_ADDR(sd), addr, sizeof(struct sockaddr_in));
+	if(-1==hash_map_add(ed->sessions, (long)IODT_PEER_ADDR(sd), (long)sd)) {
+		UNLOCK(ed->rt);
+		io_event_channel_opt_put(sd->opt);
+		mem_pool_free(sd);
+		LOG_WARN("[io_event] create udp session failed at socket=%ld, add to hash_map failed.", (long)ed->s);
+		return NULL;
+	}
+	UNLOCK(ed->rt);
+
+	if(ed->session_timeout) {
+		io_event_set_idle_timeout((struct io_handle*)sd, ed->session_timeout);
+	}
+	LOG_DEBUG("[io_event] new udp session of socket=%ld.", (long)ed->s);
+	nd.type = ENT_ACCEPT;
+	nd.data = NULL;
+	nd.addr = (const struct sockaddr*)addr;
+	nd.len = 0;
+	pf((struct io_handle*)sd, sd->channel, &nd);
+
+	return sd;
+}
+
+//batch buffers of reactor, allocated at first udp reading
+static struct udp_msg* io_event_udp_msgs(struct io_reactor *rt)
+{
+	int i;
+	char *buf;
+
+	if(rt->udp_msgs) {
+		return rt->udp_msgs;
+	}
+
+	rt->udp_msgs = (struct udp_msg*)mem_pool_malloc(sizeof(struct udp_msg)*NET_UDP_BATCH);
+	buf = mem_pool_malloc(NET_UDP_MAX_LEN*NET_UDP_BATCH);
+	if(NULL==rt->udp_msgs || NULL==buf) {
+		if(rt->udp_msgs) {
+			mem_pool_free(rt->udp_msgs);
+			rt->udp_msgs = NULL;
+		}
+		if(buf) {
+			mem_pool_free(buf);
+		}
+		return NULL;
+	}
+	for(i=0; i<NET_UDP_BATCH; ++i) {
+		rt->udp_msgs[i].buf = buf+i*NET_UDP_MAX_LEN;
+		rt->udp_msgs[i].size = NET_UDP_MAX_LEN;
+	}
+
+	return rt->udp_msgs;
+}
+
+static void io_event_read_tcp(struct io_event *ie, struct io_event_data *ed)
+{
+	int recv_len, left_len;
+	unsigned int data_len;
+	unsigned int total = 0;
+	unsigned int budget = (ed->opt->read_budget) ? (ed->opt->read_budget) : (NET_READ_BUDGET);
+	unsigned int buf_max = (ed->opt->recv_buf_max) ? (ed->opt->recv_buf_max) : (NET_RECV_BUF_MAX);
+	char *buf;
+	struct event_notify_data nd;
+
+	if(ed->read_paused) {
+		//hang up or error, handled after resuming
+		return ;
+	}
+	if(ed->renotify) {
+		//the pending data is not notified since pausing
+		ed->renotify = 0;
+		if(ed->buf_data_len>0 && -1==io_event_read_data(ed, ed->rbuf+ed->rbuf_off, ed->buf_data_len)) {
+			return ;
+		}
+		if(ed->read_paused) {
+			return ;
+		}
+	}
+
+	//edge trigger, read until EAGAIN or read budget is used up
+	while(total<budget) {
+		if(ed->rbuf) {
+			//append to pending data
+			if(-1==io_event_rbuf_space(ed)) {
+				LOG_WARN("[io_event] handle event and there is no space to receive tcp data at client=%d, pending len=%u.", ed->s, ed->buf_data_len);
+				io_event_notify_simple(ed, ENT_CLOSE, 0);
+				io_event_close_handle((struct io_handle*)ed);
+				return ;
+			}
+			buf = ed->rbuf + ed->rbuf_off + ed->buf_data_len;
+			left_len = (int)(ed->rbuf_size - ed->rbuf_off - ed->buf_data_len);
+		} else {
+			//nothing pending, the reactor buffer is used
+			if(NULL==ed->rt->read_buf && NULL==(ed->rt->read_buf = mem_pool_malloc(NET_READ_BUF_LEN))) {
+				LOG_WARN("[io_event] handle event and malloc tcp buffer failed at socket=%ld.", (long)ed->s);
+				return ;
+			}
+			buf = ed->rt->read_buf;
+			left_len = (buf_max < NET_READ_BUF_LEN) ? (int)(buf_max) : (NET_READ_BUF_LEN);
+		}
+
+		recv_len = io_event_recv(ie, (struct io_handle*)ed, buf, left_len);
+		if(recv_len>0) {
+			LOG_DEBUG("[io_event] recv data len=%d from socket=%ld, type=TCP-C.", recv_len, (long)ed->s);
+			io_event_data_active(ed);
+			total += recv_len;
+			data_len = ed->buf_data_len + recv_len;
+			buf = (ed->rbuf) ? (ed->rbuf+ed->rbuf_off) : (buf);
+			if(-1==io_event_read_data(ed, buf, data_len)) {
+				return ;
+			}
+			if((recv_len<left_len && !ed->drain) || ed->read_paused) {
+				//socket buffer is drained
+				return ;
+			}
+		}
+		else if(0==recv_len) {
+			//closed
+			nd.type = ENT_CLOSE;
+			nd.data = NULL;
+			nd.addr = NULL;
+			nd.len = 0;
+			io_event_dispatch(ed, &nd);
+			io_event_close_handle((struct io_handle*)ed);
+			return ;
+		}
+		else if(EINTR==errno) {
+			continue;
+		}
+		else if(EAGAIN==errno || EWOULDBLOCK==errno) {
+			ed->drain = 0;
+			return ;
+		}
+		else {
+			//error, such as reset by peer
+			LOG_WARN("[io_event] handle event and read tcp client=%d data failed, errno=%d.", ed->s, errno);
+			nd.type = ENT_CLOSE;
+			nd.data = NULL;
+			nd.addr = NULL;
+			nd.len = 0;
+			io_event_dispatch(ed, &nd);
+			io_event_close_handle((struct io_handle*)ed);
+			return ;
+		}
+	}
+
+	//read budget is used up, let other handles go first
+	io_event_ready_add(ed);
+}
+
+//notify received data and keep the left, reading is paused if the left reach
+//recv_high_watermark
+//return: -1 handle is closed, 0 ok
+static int io_event_read_data(struct io_event_data *ed, char *data, unsigned int len)
+{
+	int ret;
+	unsigned int watermark = ed->opt->recv_high_watermark;
+
+	ret = io_event_notify_tcp(ed, data, len);
+	if(-1==ret) {
+		LOG_WARN("[io_event] handle event and read invalid frame at client=%d.", ed->s);
+		io_event_notify_simple(ed, ENT_CLOSE, 0);
+		io_event_close_handle((struct io_handle*)ed);
+		return -1;
+	}
+	if(ed->closed) {
+		//closed by callback
+		return -1;
+	}
+	if(-1==io_event_rbuf_keep(ed, data, len, (unsigned int)ret)) {
+		LOG_WARN("[io_event] handle event and keep pending tcp data len=%u failed at client=%d.", len-(unsigned int)ret, ed->s);
+		io_event_notify_simple(ed, ENT_CLOSE, 0);
+		io_event_close_handle((struct io_handle*)ed);
+		return -1;
+	}
+	if(watermark && EFT_NONE==ed->opt->framer.type && ed->buf_data_len>=watermark) {
+		LOG_DEBUG("[io_event] pending data len=%u reach high watermark at client=%d, pause reading.", ed->buf_data_len, ed->s);
+		io_event_read_pause(ed, IO_PAUSE_BUF);
+	}
+
+	return 0;
+}
+
+//notify received data, complete frames are notified one by one if channel has framer
+//return: -1 invalid frame, other processed data len
+static int io_event_notify_tcp(struct io_event_data *ed, char *data, unsigned int len)
+{
+	int frame_len = 0;
+	unsigned int proc_len;
+	unsigned int need = 0;
+	const struct io_framer *fr = &ed->opt->framer;
+	struct event_notify_data nd;
+
+	nd.type = ENT_DATA;
+	nd.addr = NULL;
+	if(EFT_NONE==fr->type) {
+		nd.data = data;
+		nd.len = (int)len;
+		proc_len = io_event_dispatch(ed, &nd);
+		if(proc_len>len) {
+			LOG_WARN("[io_event] handle event and read tcp data len=%u, but proc_len=%u is invalid", len, proc_len);
+			proc_len = 0;
+		}
+		return (int)proc_len;
+	}
+
+	proc_len = 0;
+	while(!ed->closed && !ed->read_paused && 0<(frame_len = io_event_frame_len(ed, data+proc_len, len-proc_len, &need))) {
+		nd.data = data+proc_len;
+		nd.len = (EFT_DELIMITER==fr->type) ? (frame_len-(int)fr->delim_len) : (frame_len);
+		io_event_dispatch(ed, &nd);
+		proc_len += frame_len;
+	}
+	if(ed->closed || ed->read_paused) {
+		//the left frames are notified after resuming
+		return (int)proc_len;
+	}
+	if(-1==frame_len) {
+		return -1;
+	}
+	//no wakeup until the rest of frame arrives
+	io_event_frame_lowat(ed, need);
+
+	return (int)proc_len;
+}
+
+//len of the first frame in data
+//return: -1 invalid, 0 not complete and need is the missing bytes, other frame len
+static int io_event_frame_len(struct io_event_data *ed, const char *data, unsigned int len, unsigned int *need)
+{
+	unsigned int i, head_len;
+	unsigned long long frame_len;
+	const char *p;
+	const unsigned char *field;
+	const struct io_framer *fr = &ed->opt->framer;
+	unsigned int buf_max = (ed->opt->recv_buf_max) ? (ed->opt->recv_buf_max) : (NET_RECV_BUF_MAX);
+
+	switch(fr->type) {
+		case EFT_LENGTH:
+			head_len = fr->len_offset + fr->len_width;
+			if(len<head_len) {
+				*need = head_len - len;
+				return 0;
+			}
+			field = (const unsigned char*)data + fr->len_offset;
+			frame_len = 0;
+			for(i=0; i<fr->len_width; ++i) {
+				frame_len = (fr->len_big_endian) ? ((frame_len<<8) | field[i]) : (frame_len | ((unsigned long long)field[i]<<(8*i)));
+			}
+			frame_len += fr->len_adjust;
+			if((long long)frame_len<(long long)head_len || frame_len>buf_max) {
+				return -1;
+			}
+			if(len<frame_len) {
+				*need = (unsigned int)frame_len - len;
+				return 0;
+			}
+			return (int)frame_len;
+		case EFT_FIXED:
+			if(fr->fixed_size>buf_max) {
+				return -1;
+			}
+			if(len<fr->fixed_size) {
+				*need = fr->fixed_size - len;
+				return 0;
+			}
+			return (int)fr->fixed_size;
+		case EFT_DELIMITER:
+			//the pending data has been searched
+			for(i=ed->frame_scan; i+fr->delim_len<=len; ++i) {
+				p = (const char*)memchr(data+i, fr->delim[0], len-i-fr->delim_len+1);
+				if(NULL==p) {
+					break;
+				}
+				i = (unsigned int)(p - data);
+				if(0==memcmp(p, fr->delim, fr->delim_len)) {
+					ed->frame_scan = 0;
+					return (int)(i+fr->delim_len);
+				}
+			}
+			ed->frame_scan = (len>=fr->delim_len) ? (len-fr->delim_len+1) : (0);
+			*need = 0;
+			return 0;
+		default:
+			return -1;
+	}
+}
+
+//set SO_RCVLOWAT to the missing bytes of frame, 0 is nothing missing
+static void io_event_frame_lowat(struct io_event_data *ed, unsigned int need)
+{
+	need = (need>NET_RCVLOWAT_MAX) ? (NET_RCVLOWAT_MAX) : ((need>0) ? (need) : (1));
+	if(need!=ed->rcvlowat && 0==socket_set_rcvlowat(ed->s, (int)need)) {
+		ed->rcvlowat = need;
+	}
+}
+
+//keep data not processed by callback, the buffer is released if nothing is left,
+//processed data only advances rbuf_off, the space is reclaimed when buffer is full
+static int io_event_rbuf_keep(struct io_event_data *ed, const char *data, unsigned int len, unsigned int proc_len)
+{
+	unsigned int size;
+	unsigned int left = len - proc_len;
+	unsigned int buf_max = (ed->opt->recv_buf_max) ? (ed->opt->recv_buf_max) : (NET_RECV_BUF_MAX);
+
+	if(0==left) {
+		if(ed->rbuf) {
+			mem_pool_free(ed->rbuf);
+			ed->rbuf = NULL;
+			ed->rbuf_size = 0;
+		}
+		ed->rbuf_off = 0;
+		ed->buf_data_len = 0;
+		return 0;
+	}
+
+	if(NULL==ed->rbuf) {
+		//data is in reactor buffer, mem pool block is power of 2
+		for(size=NET_BUF_MAX_LEN; size<left && size<buf_max; size<<=1);
+		size = (size>buf_max) ? (buf_max) : (size);
+		if(size<left || NULL==(ed->rbuf = mem_pool_malloc(size))) {
+			return -1;
+		}
+		ed->rbuf_size = size;
+		ed->rbuf_off = 0;
+		memcpy(ed->rbuf, data+proc_len, left);
+	} else {
+		ed->rbuf_off += proc_len;
+	}
+	ed->buf_data_len = left;
+
+	return 0;
+}
+
+//make space at the end of receiving buffer, pending data is moved to the front
+//only if the end is short of space, the full buffer is doubled, not more than
+//recv_buf_max of channel
+static int io_event_rbuf_space(struct io_event_data *ed)
+{
+	char *buf;
+	unsigned int size;
+	unsigned int tail = ed->rbuf_size - ed->rbuf_off - ed->buf_data_len;
+	unsigned int buf_max = (ed->opt->recv_buf_max) ? (ed->opt->recv_buf_max) : (NET_RECV_BUF_MAX);
+
+	if(ed->rbuf_off>0 && tail<ed->rbuf_size/4) {
+		memmove(ed->rbuf, ed->rbuf+ed->rbuf_off, ed->buf_data_len);
+		ed->rbuf_off = 0;
+		return 0;
+	}
+	if(tail>0) {
+		return 0;
+	}
+	if(ed->rbuf_size>=buf_max) {
+		return -1;
+	}
+	size = (ed->rbuf_size*2 > buf_max) ? (buf_max) : (ed->rbuf_size*2);
+	buf = mem_pool_malloc(size);
+	if(NULL==buf) {
+		return -1;
+	}
+	memcpy(buf, ed->rbuf, ed->buf_data_len);
+	mem_pool_free(ed->rbuf);
+	ed->rbuf = buf;
+	ed->rbuf_size = size;
+
+	return 0;
+}
+
+
+//monitored events of connection
+static unsigned int io_event_interest(struct io_event_data *ed)
+{
+	if(ed->connecting) {
+		//writable or error completes the connecting
+		return IO_EVENT_WRITE;
+	}
+	//the thread sending flushes the queue by itself
+	return ((ed->read_paused) ? (0) : (IO_EVENT_READ)) | ((ed->out_head && !ed->sending) ? (IO_EVENT_WRITE) : (0));
+}
+
+//stop monitoring readable, the kernel buffer fills and tcp window throttles the peer
+static void io_event_read_pause(struct io_event_data *ed, unsigned int reason)
+{
+	int mod = 0;
+
+	LOCK(ed->rt);
+	if(0==ed->read_paused && !ed->closed) {
+		ed->read_paused = reason;
+		mod = io_event_interest_begin_locked(ed);
+	} else {
+		ed->read_paused |= reason;
+	}
+	UNLOCK(ed->rt);
+
+	if(mod) {
+		io_event_interest_apply(ed);
+	}
+}
+
+//monitor readable again if nothing else pauses it, the pending data is notified
+//again by reactor
+static void io_event_read_resume(struct io_event_data *ed, unsigned int reason)
+{
+	int renotify = 0, mod = 0;
+	struct io_reactor *rt = ed->rt;
+
+	LOCK(rt);
+	if(ed->read_paused&reason) {
+		ed->read_paused &= ~reason;
+		if(0==ed->read_paused && !ed->closed) {
+			ed->drain = 1;
+			renotify = ed->renotify = (ed->buf_data_len>0);
+			mod = io_event_interest_begin_locked(ed);
+		}
+	}
+	UNLOCK(rt);
+
+	if(mod) {
+		io_event_interest_apply(ed);
+	}
+
+	if(renotify) {
+		io_event_ready_add(ed);
+		if(t_reactor!=rt) {
+			io_event_wakeup(rt->ie);
+		}
+	}
+}
+
+//notify outside, ENT_ACCEPT/ENT_DATA/ENT_CLOSE/ENT_CONNECT of worker channel are queued to worker
+//return: processed data len of ENT_DATA, all for worker
+static unsigned int io_event_dispatch(struct io_event_data *ed, struct event_notify_data *nd)
+{
+	if(ed->pool && IO_POOL_USED!=ed->pool_state && io_event_pool_notify(ed, nd)) {
+		//warming or idle in pool
+		return (ENT_DATA==nd->type) ? ((unsigned int)nd->len) : (0);
+	}
+	if(NULL==g_workers || 0==ed->opt->worker || EST_TCP_CLIENT!=ed->type
+		|| (nd->type>ENT_CLOSE && ENT_CONNECT!=nd->type) || -1==io_event_worker_push(ed, nd)) {
+		return g_nt_func((struct io_handle*)ed, ed->channel, nd);
+	}
+	return (ENT_DATA==nd->type) ? ((unsigned int)nd->len) : (0);
+}
+
+//queue event to the worker of connection, the data is copied, reading is paused
+//if the queue is full
+static int io_event_worker_push(struct io_event_data *ed, struct event_notify_data *nd)
+{
+	int pause = 0;
+	int len = (ENT_DATA==nd->type) ? (nd->len) : (0);
+	struct io_work *wk;
+	struct io_worker *w = &g_workers[(unsigned long)ed->s % (unsigned long)g_worker_count];
+
+	wk = (struct io_work*)mem_pool_malloc(sizeof(struct io_work)+len);
+	if(NULL==wk) {
+		LOG_WARN("[io_event] queue event to worker failed at socket=%ld, malloc len=%d failed.", (long)ed->s, len);
+		return -1;
+	}
+	wk->next = NULL;
+	wk->ed = ed;
+	wk->type = nd->type;
+	wk->len = len;
+	if(nd->addr) {
+		memcpy(&wk->addr, nd->addr, sizeof(struct sockaddr_in));
+	}
+	if(len>0) {
+		memcpy(wk->data, nd->data, len);
+	}
+
+	//pinned until notified, a connection closed meanwhile waits in free_wait
+	//without polling of its reactor, see io_event_free_closed
+	LOCK(ed->rt);
+	++ed->refs;
+	UNLOCK(ed->rt);
+
+	lock_lock(w->tlock);
+	if(w->tail) {
+		w->tail->next = wk;
+	} else {
+		w->head = wk;
+	}
+	w->tail = wk;
+	//the data is read by reactor of connection, pause it
+	if(++w->count>=g_worker_queue && ENT_DATA==nd->type && 0==(ed->read_paused&IO_PAUSE_WORKER) && t_reactor==ed->rt) {
+		pause = 1;
+		ed->pause_next = w->paused;
+		w->paused = ed;
+	}
+	lock_unlock(w->tlock);
+	thread_wait_signal(w->tw);
+
+	if(pause) {
+		LOCK(ed->rt);
+		++ed->refs;
+		UNLOCK(ed->rt);
+		io_event_read_pause(ed, IO_PAUSE_WORKER);
+	}
+
+	return 0;
+}
+
+static int io_event_workers_init()
+{
+	int i;
+
+	g_workers = (struct io_worker*)mem_pool_malloc(sizeof(struct io_worker)*g_worker_count);
+	if(NULL==g_workers) {
+		return -1;
+	}
+	memset(g_workers, 0, sizeof(struct io_worker)*g_worker_count);
+
+	for(i=0; i<g_worker_count; ++i) {
+		g_workers[i].tlock = lock_create_critical_section();
+		g_workers[i].tw = thread_wait_create();
+		if(NULL==g_workers[i].tlock || NULL==g_workers[i].tw
+			|| NULL==(g_workers[i].th = thread_create(worker_run, &g_workers[i]))) {
+			LOG_WARN("[io_event] init worker=%d failed.", i);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+//stop workers, the queued events are dropped
+static void io_event_workers_release()
+{
+	int i;
+	struct io_worker *w;
+	struct io_work *wk;
+	struct io_event_data *ed;
+
+	if(NULL==g_workers) {
+		return ;
+	}
+
+	for(i=0; i<g_worker_count; ++i) {
+		w = &g_workers[i];
+		if(w->th) {
+			lock_lock(w->tlock);
+			w->stop = 1;
+			lock_unlock(w->tlock);
+			thread_wait_signal(w->tw);
+			thread_join(&w->th);
+		}
+		while(NULL != (wk = w->head)) {
+			w->head = wk->next;
+			--wk->ed->refs;
+			mem_pool_free(wk);
+		}
+		while(NULL != (ed = w->paused)) {
+			w->paused = ed->pause_next;
+			--ed->refs;
+		}
+		if(w->tw) {
+			thread_wait_destroy(w->tw);
+		}
+		if(w->tlock) {
+			lock_destroy(w->tlock);
+		}
+	}
+	mem_pool_free(g_workers);
+	g_workers = NULL;
+}
+
+static void worker_run(void *arg)
+{
+	unsigned int cnt;
+	struct io_worker *w = (struct io_worker*)arg;
+	struct io_work *works, *wk;
+	struct io_event_data *paused, *ed;
+	struct io_cmd *cmd;
+	struct event_notify_data nd;
+
+	while(1) {
+		lock_lock(w->tlock);
+		if(w->stop) {
+			lock_unlock(w->tlock);
+			break;
+		}
+		works = w->head;
+		w->head = w->tail = NULL;
+		lock_unlock(w->tlock);
+		if(NULL==works) {
+			thread_wait(w->tw);
+			continue;
+		}
+
+		for(cnt=0; NULL != (wk = works); ++cnt) {
+			works = wk->next;
+			nd.type = wk->type;
+			nd.data = (wk->len>0) ? (wk->data) : (NULL);
+			nd.len = wk->len;
+			nd.addr = (ENT_ACCEPT==wk->type) ? ((const struct sockaddr*)&wk->addr) : (NULL);
+			g_nt_func((struct io_handle*)wk->ed, wk->ed->channel, &nd);
+			io_event_unpin(wk->ed);
+			mem_pool_free(wk);
+		}
+
+		//resume the paused handles when half of queue is drained
+		paused = NULL;
+		lock_lock(w->tlock);
+		w->count -= cnt;
+		if(w->count<=g_worker_queue/2) {
+			paused = w->paused;
+			w->paused = NULL;
+		}
+		lock_unlock(w->tlock);
+		while(NULL != (ed = paused)) {
+			paused = ed->pause_next;
+			cmd = (struct io_cmd*)malloc(sizeof(struct io_cmd));
+			if(NULL==cmd) {
+				LOG_WARN("[io_event] resume reading failed at socket=%ld, malloc failed.", (long)ed->s);
+				io_event_unpin(ed);
+				continue;
+			}
+			cmd->type = EICT_RESUME;
+			cmd->id = (unsigned long long)ed->rt->id<<IO_ID_SOCKET_BITS;
+			cmd->arg = ed;
+			cmd->len = 0;
+			io_event_post_cmd(cmd);
+		}
+	}
+}
+
+static int io_event_pools_init()
+{
+	struct hash_map_func hmf;
+
+	g_pool_tlock = lock_create_critical_section();
+	if(NULL==g_pool_tlock) {
+		return -1;
+	}
+	hash_map_inner_hmf(&hmf, EFI_LONG_LONG);
+	hmf.hash = pool_hash;
+	hmf.compare = pool_compare;
+	hmf.isvalid_key = hash_map_isvalid_val;
+	hmf.isvalid_val = hash_map_isvalid_val;
+	hmf.free_val = pool_free_val;
+	g_pools = hash_map_create(16, &hmf);
+
+	return (g_pools) ? (0) : (-1);
+}
+
+//drop pools after reactors stop, the pinned connections are released by reactors
+static void io_event_pools_release()
+{
+	if(g_pools) {
+		hash_map_destroy(g_pools);
+		g_pools = NULL;
+	}
+	if(g_pool_tlock) {
+		lock_destroy(g_pool_tlock);
+		g_pool_tlock = NULL;
+	}
+}
+
+static struct io_pool* io_event_pool_find_locked(const char *ip, unsigned short port, unsigned short channel)
+{
+	long val;
+	struct io_pool_key key;
+
+	if(NULL==ip || '\0'==*ip) {
+		return NULL;
+	}
+	key.ip = socket_convert_ip2val(ip);
+	key.port = port;
+	key.channel = channel;
+
+	return (0==hash_map_find(g_pools, (long)&key, &val)) ? ((struct io_pool*)val) : (NULL);
+}
+
+//change state of connection in pool, the dropped is removed from list
+//and its pin is dropped by caller
+static void io_event_pool_move_locked(struct io_pool *pool, struct io_event_data *ed, int state)
+{
+	struct io_event_data **pp;
+
+	switch(ed->pool_state) {
+		case IO_POOL_USED:
+			--pool->used;
+			break;
+		case IO_POOL_CONNECTING:
+			--pool->connecting;
+			break;
+		case IO_POOL_IDLE:
+			--pool->idle;
+			break;
+		default:
+			break;
+	}
+	switch(state) {
+		case IO_POOL_USED:
+			++pool->used;
+			break;
+		case IO_POOL_CONNECTING:
+			++pool->connecting;
+			break;
+		case IO_POOL_IDLE:
+			++pool->idle;
+			ed->pool_time = timer_wheel_now();
+			break;
+		default:
+		//case IO_POOL_DROPPED:
+			for(pp=&pool->head; *pp; pp=&(*pp)->pool_next) {
+				if(*pp==ed) {
+					*pp = ed->pool_next;
+					break;
+				}
+			}
+			ed->pool_next = NULL;
+			break;
+	}
+	ed->pool_state = state;
+}
+
+//reserve connecting for the lack of idle connections, the used ones are
+//counted since they are usually put back, or every get makes a new connection
+//return: number of connections to fill
+static unsigned int io_event_pool_reserve_locked(struct io_pool *pool)
+{
+	unsigned int count = 0;
+	unsigned int total = pool->idle + pool->connecting + pool->used;
+
+	if(total<pool->opt.idle_count) {
+		count = pool->opt.idle_count - total;
+		pool->connecting += count;
+	}
+
+	return count;
+}
+
+static void io_event_pool_fill(struct io_pool *pool, unsigned int count)
+{
+	unsigned int failed = 0;
+
+	while(count-- > 0) {
+		if(NULL==io_event_connect_handle(pool->ip, pool->key.port, pool->key.channel, pool->opt.connect_timeout, pool, IO_POOL_CONNECTING)) {
+			++failed;
+		}
+	}
+	if(failed>0) {
+		//refilled by next check
+		lock_lock(g_pool_tlock);
+		pool->connecting -= failed;
+		lock_unlock(g_pool_tlock);
+	}
+}
+
+//events of warming or idle connection, called by its reactor
+//return: 1 handled by pool, 0 the connection has been got by user
+static int io_event_pool_notify(struct io_event_data *ed, struct event_notify_data *nd)
+{
+	int drop = 0;
+	int handled = 1;
+	struct io_pool *pool = ed->pool;
+
+	lock_lock(g_pool_tlock);
+	switch(ed->pool_state) {
+		case IO_POOL_USED:
+			handled = 0;
+			break;
+		case IO_POOL_CONNECTING:
+			if(ENT_CONNECT==nd->type && 0==nd->len && pool->idle<pool->opt.idle_count) {
+				io_event_pool_move_locked(pool, ed, IO_POOL_IDLE);
+			} else {
+				//failed, or not needed since connections are put back
+				drop = 1;
+			}
+			break;
+		case IO_POOL_IDLE:
+			//nothing is expected from server before request
+			drop = (ENT_DATA==nd->type || ENT_CLOSE==nd->type);
+			break;
+		default:
+		//case IO_POOL_DROPPED:
+			break;
+	}
+	if(drop) {
+		io_event_pool_move_locked(pool, ed, IO_POOL_DROPPED);
+	}
+	lock_unlock(g_pool_tlock);
+
+	if(drop) {
+		LOG_DEBUG("[io_event] drop socket=%ld from pool, event=%d len=%d.", (long)ed->s, nd->type, nd->len);
+		//in reactor of connection, it is not released before the return
+		io_event_unpin(ed);
+		if(ENT_CLOSE!=nd->type && !(ENT_CONNECT==nd->type && nd->len)) {
+			io_event_close_handle((struct io_handle*)ed);
+		}
+	}
+
+	return handled;
+}
+
+//close the broken and expired idle connections, refill the lack
+static void io_event_pool_check(struct io_timer *timer, void *arg)
+{
+	int err, closed;
+	unsigned int i, count = 0;
+	unsigned long long now = timer_wheel_now();
+	struct io_pool *pool = (struct io_pool*)arg;
+	struct io_event_data *ed, *next, *drops = NULL;
+	struct io_event_data **probes = NULL;
+
+	//use variable only for compiler
+	(void)timer;
+
+	lock_lock(g_pool_tlock);
+	if(pool->idle>0) {
+		//probed without the pool lock
+		probes = (struct io_event_data**)mem_pool_malloc(pool->idle*sizeof(struct io_event_data*));
+	}
+	for(ed=pool->head; ed; ed=next) {
+		next = ed->pool_next;
+		if(IO_POOL_IDLE!=ed->pool_state) {
+			continue;
+		}
+		if(pool->opt.idle_time_max>0 && now-ed->pool_time>=pool->opt.idle_time_max) {
+			LOG_DEBUG("[io_event] drop socket=%ld from pool, expired.", (long)ed->s);
+			io_event_pool_move_locked(pool, ed, IO_POOL_DROPPED);
+			ed->pool_next = drops;
+			drops = ed;
+		} else if(probes) {
+			//pinned for probing, it may be got or dropped meanwhile
+			LOCK(ed->rt);
+			++ed->refs;
+			UNLOCK(ed->rt);
+			probes[count++] = ed;
+		}
+	}
+	lock_unlock(g_pool_tlock);
+
+	for(i=0; i<count; ++i) {
+		ed = probes[i];
+		LOCK(ed->rt);
+		closed = ed->closed;
+		UNLOCK(ed->rt);
+		//the socket is kept while pinned
+		err = (closed) ? (0) : (socket_get_error(ed->s));
+		if(closed || err) {
+			lock_lock(g_pool_tlock);
+			if(IO_POOL_IDLE==ed->pool_state) {
+				LOG_DEBUG("[io_event] drop socket=%ld from pool, closed=%d err=%d.", (long)ed->s, closed, err);
+				io_event_pool_move_locked(pool, ed, IO_POOL_DROPPED);
+				ed->pool_next = drops;
+				drops = ed;
+			}
+			lock_unlock(g_pool_tlock);
+		}
+		io_event_unpin(ed);
+	}
+	if(probes) {
+		mem_pool_free(probes);
+	}
+
+	lock_lock(g_pool_tlock);
+	count = io_event_pool_reserve_locked(pool);
+	lock_unlock(g_pool_tlock);
+
+	//the connection may belong to other reactor, close it before unpinning
+	while(NULL != (ed = drops)) {
+		drops = ed->pool_next;
+		io_event_close_handle((struct io_handle*)ed);
+		io_event_unpin(ed);
+	}
+	io_event_pool_fill(pool, count);
+}
+
+static int io_event_dns_init()
+{
+	struct hash_map_func hmf;
+
+	g_dns_tlock = lock_create_critical_section();
+	if(NULL==g_dns_tlock) {
+		return -1;
+	}
+	hash_map_inner_hmf(&hmf, EFI_LONG_LONG);
+	hmf.hash = dns_hash;
+	hmf.compare = dns_compare;
+	hmf.isvalid_key = hash_map_isvalid_val;
+	hmf.isvalid_val = hash_map_isvalid_val;
+	hmf.free_val = dns_free_val;
+	g_dns_cache = hash_map_create(64, &hmf);
+
+	return (g_dns_cache) ? (0) : (-1);
+}
+
+//stop resolvers after reactors stop, the waiting requests are dropped
+static void io_event_dns_release()
+{
+	int i;
+	struct io_resolver *r;
+
+	if(g_resolvers) {
+		for(i=0; i<g_resolver_count; ++i) {
+			r = &g_resolvers[i];
+			if(r->th) {
+				lock_lock(g_dns_tlock);
+				r->stop = 1;
+				lock_unlock(g_dns_tlock);
+				thread_wait_signal(r->tw);
+				thread_join(&r->th);
+			}
+			if(r->tw) {
+				thread_wait_destroy(r->tw);
+			}
+		}
+		mem_pool_free(g_resolvers);
+		g_resolvers = NULL;
+	}
+	if(g_dns_cache) {
+		hash_map_destroy(g_dns_cache);
+		g_dns_cache = NULL;
+		g_dns_head = NULL;
+		g_dns_tail = NULL;
+	}
+	if(g_dns_tlock) {
+		lock_destroy(g_dns_tlock);
+		g_dns_tlock = NULL;
+	}
+}
+
+//move cache entry to the tail as the most recently resolved
+static void io_event_dns_touch_locked(struct io_dns *dns)
+{
+	if(dns->lru_prev || g_dns_head==dns) {
+		if(dns->lru_prev) {
+			dns->lru_prev->lru_next = dns->lru_next;
+		} else {
+			g_dns_head = dns->lru_next;
+		}
+		if(dns->lru_next) {
+			dns->lru_next->lru_prev = dns->lru_prev;
+		} else {
+			g_dns_tail = dns->lru_prev;
+		}
+	}
+	dns->lru_prev = g_dns_tail;
+	dns->lru_next = NULL;
+	if(g_dns_tail) {
+		g_dns_tail->lru_next = dns;
+	} else {
+		g_dns_head = dns;
+	}
+	g_dns_tail = dns;
+}
+
+//drop the expired from the least recently resolved, and the oldest if the cache
+//is full, the resolving ones are kept for their requests
+static void io_event_dns_evict_locked(unsigned long long now)
+{
+	struct io_dns *dns, *next;
+
+	for(dns=g_dns_head; dns; dns=next) {
+		next = dns->lru_next;
+		if(dns->resolving) {
+			continue;
+		}
+		if(now<dns->expire && hash_map_count(g_dns_cache)<NET_RESOLVE_CACHE_MAX) {
+			break;
+		}
+		if(dns->lru_prev) {
+			dns->lru_prev->lru_next = next;
+		} else {
+			g_dns_head = next;
+		}
+		if(next) {
+			next->lru_prev = dns->lru_prev;
+		} else {
+			g_dns_tail = dns->lru_prev;
+		}
+		//freed by dns_free_val
+		hash_map_del(g_dns_cache, (long)dns->host);
+	}
+}
+
+//g_dns_tlock is released while the started are stopped on failure, or the
+//requests hashed to the failed one hang
+static int io_event_resolvers_start_locked()
+{
+	int i, n;
+	struct io_resolver *rs;
+
+	if(g_resolvers) {
+		return 0;
+	}
+
+	rs = (struct io_resolver*)mem_pool_malloc(sizeof(struct io_resolver)*g_resolver_count);
+	if(NULL==rs) {
+		return -1;
+	}
+	memset(rs, 0, sizeof(struct io_resolver)*g_resolver_count);
+
+	for(i=0; i<g_resolver_count; ++i) {
+		rs[i].tw = thread_wait_create();
+		if(NULL==rs[i].tw || NULL==(rs[i].th = thread_create(resolver_run, &rs[i]))) {
+			LOG_WARN("[io_event] start resolver=%d failed.", i);
+			break;
+		}
+	}
+	if(i==g_resolver_count) {
+		g_resolvers = rs;
+		return 0;
+	}
+
+	for(n=0; n<i; ++n) {
+		rs[n].stop = 1;
+	}
+	lock_unlock(g_dns_tlock);
+	for(n=0; n<=i; ++n) {
+		if(rs[n].th) {
+			thread_wait_signal(rs[n].tw);
+			thread_join(&rs[n].th);
+		}
+		if(rs[n].tw) {
+			thread_wait_destroy(rs[n].tw);
+		}
+	}
+	mem_pool_free(rs);
+	lock_lock(g_dns_tlock);
+
+	return -1;
+}
+
+static void resolver_run(void *arg)
+{
+	int count;
+	unsigned int ips[NET_RESOLVE_IP_MAX];
+	struct io_resolver *r = (struct io_resolver*)arg;
+	struct io_dns *dns;
+	struct io_cmd *waits, *wait;
+	struct io_dns_result *res;
+
+	while(1) {
+		lock_lock(g_dns_tlock);
+		if(r->stop) {
+			lock_unlock(g_dns_tlock);
+			break;
+		}
+		if(NULL != (dns = r->head)) {
+			r->head = dns->next;
+			if(NULL==r->head) {
+				r->tail = NULL;
+			}
+		}
+		lock_unlock(g_dns_tlock);
+		if(NULL==dns) {
+			thread_wait(r->tw);
+			continue;
+		}
+
+		//the cache entry is not evicted while resolving
+		count = socket_resolve_host(dns->host, ips, NET_RESOLVE_IP_MAX);
+		if(count<0) {
+			count = 0;
+		}
+
+		lock_lock(g_dns_tlock);
+		dns->count = count;
+		memcpy(dns->ips, ips, sizeof(unsigned int)*count);
+		dns->expire = timer_wheel_now() + ((count>0) ? (g_resolve_ttl) : (g_resolve_neg_ttl));
+		dns->resolving = 0;
+		io_event_dns_touch_locked(dns);
+		waits = dns->waits;
+		dns->waits = NULL;
+		lock_unlock(g_dns_tlock);
+
+		while(NULL != (wait = waits)) {
+			waits = wait->next;
+			res = (struct io_dns_result*)wait->data;
+			res->count = count;
+			memcpy(res->ips, ips, sizeof(unsigned int)*count);
+			io_event_post_cmd(wait);
+		}
+	}
+}
+
+//task of notifying result in reactor, the result is in the command, so it is
+//freed with the dropped commands
+static struct io_cmd* io_event_resolve_cmd(struct io_reactor *rt, const char *host, pfunc_resolve_notify pf, void *arg)
+{
+	struct io_cmd *cmd;
+	struct io_dns_result *res;
+
+	cmd = (struct io_cmd*)malloc(sizeof(struct io_cmd)+sizeof(struct io_dns_result));
+	if(NULL==cmd) {
+		LOG_WARN("[io_event] notify resolving of %s failed, malloc failed.", host);
+		return NULL;
+	}
+	res = (struct io_dns_result*)cmd->data;
+	res->pf = pf;
+	res->arg = arg;
+	res->count = 0;
+	strcpy(res->host, host);
+	cmd->type = EICT_TASK;
+	cmd->id = (unsigned long long)rt->id<<IO_ID_SOCKET_BITS;
+	cmd->pf = io_event_resolve_notify;
+	cmd->arg = res;
+	cmd->len = 0;
+
+	return cmd;
+}
+
+//post cached result to reactor as task
+static int io_event_resolve_post(struct io_reactor *rt, const char *host, const unsigned int *ips, int count, pfunc_resolve_notify pf, void *arg)
+{
+	struct io_cmd *cmd;
+	struct io_dns_result *res;
+
+	cmd = io_event_resolve_cmd(rt, host, pf, arg);
+	if(NULL==cmd) {
+		return -1;
+	}
+	res = (struct io_dns_result*)cmd->data;
+	res->count = count;
+	memcpy(res->ips, ips, sizeof(unsigned int)*count);
+
+	return io_event_post_cmd(cmd);
+}
+
+static void io_event_resolve_notify(void *arg)
+{
+	struct io_dns_result *res = (struct io_dns_result*)arg;
+	res->pf(res->host, res->ips, res->count, res->arg);
+}
@@ -1,117 +1,551 @@
-/**********************************************************
-* file: io_event.h
-* brief: IO event model, such as select/epoll/iocp
-* 
-* author: qk
-* email: 
-* date: 2018-08
-* modify date: 
-**********************************************************/
-
-#ifndef _IO_EVENT_H_
-#define _IO_EVENT_H_
-
-#include "net_error.h"
-
-//recvf buf max len
-#define NET_BUF_MAX_LEN (1024*5)
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-//notify type
-enum EEV_NOTIFY_TYPE {
-	ENT_ACCEPT=0,
-	ENT_DATA,
-	ENT_CLOSE
-};
-//notify data
-struct event_notify_data {
-	enum EEV_NOTIFY_TYPE type;
-	char *data;
-	int len;
-};
-struct io_handle;
-//event notify callback
-//return: if nd->type==EIO_ENT_DATA, processed data len, other type ignore
-typedef unsigned int (*pfunc_event_notify)(const struct io_handle *handle, unsigned short channel, struct event_notify_data *nd);
-
-
-/**********************************************************
- * brief: init io_event env
- * input: size, the max number of monitored socket
- *        pf, event notify callback function
- *
- * return: -1 error, 0 ok
- *********************************************************/
-int io_event_init(int size, pfunc_event_notify pf);
-
-/**********************************************************
- * brief: create tcp server/connection and monitor it
- * input: ip, host ip addr or null/empty string
- *        port, host port
- *        channel, id value for different communication
- *
- * return: NULL error, other ok
- *********************************************************/
-struct io_handle* io_event_create_tcp(const char *ip, unsigned short port, unsigned short channel);
-
-/**********************************************************
- * brief: create udp server/connection and monitor it
- * input: ip, host ip addr or null/empty string
- *        port, host port
- *        channel, id value for different communication
- *
- * return: NULL error, other ok
- *********************************************************/
-struct io_handle* io_event_create_udp(const char *ip, unsigned short port, unsigned short channel);
-
-/**********************************************************
- * brief: close io_handle and not to monitor it
- * input: hd, io_handle
- *
- * return: None
- *********************************************************/
-void io_event_close_handle(struct io_handle *hd);
-
-/**********************************************************
- * brief: send data on io_handle hd
- * input: hd, io handle
- *        data, will send data
- *        len, data len
- *
- * return: -1 error, >=0 actually len send data
- *********************************************************/
-int io_event_send_data(struct io_handle *hd, const char *data, int len);
-
-/**********************************************************
- * brief: start thread for monitor io event
- * input: None
- *
- * return: -1 error, 0 ok
- *********************************************************/
-int io_event_run();
-
-/**********************************************************
- * brief: stop thread that monitoring io event
- * input: None
- *
- * return: None
- *********************************************************/
-void io_event_stop();
-
-/**********************************************************
- * brief: release io_event env
- * input: None
- *
- * return: None
- *********************************************************/
-void io_event_release();
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif//_IO_EVENT_H_
-
+/**********************************************************
+* file: io_event.h
+* brief: IO event model, such as select/epoll/iocp
+* 
+* author: qk
+* email: 
+* date: 2018-08
+* modify date: 
+**********************************************************/
+
+#ifndef _IO_EVENT_H_
+#define _IO_EVENT_H_
+
+#include "net_error.h"
+
+//initial len of receiving buffer of tcp connection, allocated while data is pending
+#define NET_BUF_MAX_LEN (1024*4)
+//default max len of receiving buffer of tcp connection
+#define NET_RECV_BUF_MAX (1024*1024)
+//max len of received udp datagram
+#define NET_UDP_MAX_LEN (1024*64)
+//count of udp datagrams received by one call
+#define NET_UDP_BATCH (16)
+//suggested min data len of zerocopy send, copy is faster if less
+#define NET_ZEROCOPY_THRESHOLD (1024*10)
+//default bytes read from one connection in one loop
+#define NET_READ_BUDGET (1024*64)
+//default max queued events of one worker thread
+#define NET_WORKER_QUEUE (1024)
+//default milliseconds between health checks of connection pool
+#define NET_POOL_CHECK_INTERVAL (1000)
+//default resolver threads
+#define NET_RESOLVER_THREAD (2)
+//default milliseconds of cached resolving result and failure
+#define NET_RESOLVE_TTL     (1000*60)
+#define NET_RESOLVE_NEG_TTL (1000*5)
+//max ipv4 addrs of one resolving result
+#define NET_RESOLVE_IP_MAX (8)
+//max length of resolved host
+#define NET_HOST_LEN (256)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//notify type
+enum EEV_NOTIFY_TYPE {
+	ENT_ACCEPT=0,
+	ENT_DATA,
+	ENT_CLOSE,
+	ENT_SEND_HIGH, //queued send data reach high watermark, len is queued bytes
+	ENT_SEND_LOW,  //queued send data fall to low watermark after ENT_SEND_HIGH
+	ENT_SEND_DONE, //zerocopy send data can be reused, data/len is that of io_event_send_data
+	ENT_CONNECT    //io_event_connect_async completed, len is 0 connected, other error code
+};
+//notify data
+struct event_notify_data {
+	enum EEV_NOTIFY_TYPE type;
+	char *data;
+	int len;
+	const struct sockaddr *addr; //peer address of udp datagram, NULL for others
+};
+//io event backend of reactors
+enum EIO_BACKEND {
+	EIB_EPOLL=0, //epoll on linux, iocp on windows
+	EIB_URING    //io_uring on linux, accepts and receives by its operations, fallback to EIB_EPOLL if not supported
+};
+//message framing of tcp channel
+enum EFRAME_TYPE {
+	EFT_NONE=0,    //no framing, callback returns processed data len
+	EFT_LENGTH,    //header with length field
+	EFT_DELIMITER, //frame ends with delimiter, delimiter is not notified
+	EFT_FIXED      //fixed size frame
+};
+struct io_framer {
+	enum EFRAME_TYPE type;
+	unsigned short len_offset; //EFT_LENGTH, offset of length field in header
+	unsigned short len_width;  //EFT_LENGTH, bytes of length field, 1/2/4
+	int len_big_endian;        //EFT_LENGTH, byte order of length field
+	int len_adjust;            //EFT_LENGTH, frame len = value of length field + len_adjust
+	unsigned int fixed_size;   //EFT_FIXED, frame len
+	unsigned int delim_len;    //EFT_DELIMITER, 1~8
+	char delim[8];             //EFT_DELIMITER
+};
+//channel option
+struct io_channel_opt {
+	unsigned int send_high_watermark; //bytes, notify ENT_SEND_HIGH when queued data reach it
+	unsigned int send_low_watermark;  //bytes, notify ENT_SEND_LOW when queued data fall to it
+	int listen_backlog; //listening queue length of tcp server, <=0 SOMAXCONN
+	unsigned int read_budget; //bytes read from one connection in one loop, 0 NET_READ_BUDGET
+	unsigned int recv_buf_max; //bytes, max pending data of tcp connection, 0 NET_RECV_BUF_MAX
+	unsigned int recv_high_watermark; //bytes, reading of tcp connection without framer is paused when
+	                                  //pending data reach it, until io_event_resume_read, 0 never
+	struct io_framer framer; //ENT_DATA of tcp is one complete frame if framer.type!=EFT_NONE
+	int worker; //1 ENT_ACCEPT/ENT_DATA/ENT_CLOSE/ENT_CONNECT of tcp connections are notified in
+	            //worker threads, the return of ENT_DATA is ignored, see io_event_set_worker
+	int connect_fastopen; //1 io_event_connect_async with TCP_FASTOPEN_CONNECT, linux only
+};
+//option of outbound connection pool
+struct io_pool_opt {
+	unsigned int idle_count;      //warm connections kept in pool, the got ones count until put or closed
+	unsigned int idle_time_max;   //milliseconds, idle connection is closed after it, 0 never
+	unsigned int check_interval;  //milliseconds of health check and refilling, 0 NET_POOL_CHECK_INTERVAL
+	unsigned int connect_timeout; //milliseconds of connecting, 0 the timeout of system
+};
+struct io_handle;
+struct io_timer;
+struct iovec;
+struct sockaddr;
+struct udp_msg;
+//timer notify callback, called in the reactor thread that drives the timer
+typedef void (*pfunc_timer_notify)(struct io_timer *timer, void *arg);
+//task callback, called in the reactor thread that the task is posted to
+typedef void (*pfunc_reactor_task)(void *arg);
+//resolving callback, called in reactor thread, ips are ipv4 values in network
+//byte order, count 0 failed
+typedef void (*pfunc_resolve_notify)(const char *host, const unsigned int *ips, int count, void *arg);
+//event notify callback, ENT_DATA of udp is one datagram
+//return: if nd->type==EIO_ENT_DATA of tcp, processed data len, the left is notified
+//        again with next data, other type or channel with framer ignore
+typedef unsigned int (*pfunc_event_notify)(const struct io_handle *handle, unsigned short channel, struct event_notify_data *nd);
+
+
+/**********************************************************
+ * brief: init io_event env
+ * input: size, the max number of monitored socket
+ *        pf, event notify callback function
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_init(int size, pfunc_event_notify pf);
+
+/**********************************************************
+ * brief: init io_event env with multi reactors, every reactor
+ *        owns an io_event object, connection table and thread,
+ *        new handles/accepted clients are spread over reactors
+ * input: size, the max number of monitored socket
+ *        reactor_count, the number of reactors, <=0 one per cpu core
+ *        pf, event notify callback function
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_init_ex(int size, int reactor_count, pfunc_event_notify pf);
+
+/**********************************************************
+ * brief: select io event backend for the reactors created by
+ *        io_event_init/io_event_init_ex, default EIB_EPOLL
+ * input: backend, io event backend
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_set_backend(enum EIO_BACKEND backend);
+
+/**********************************************************
+ * brief: set worker threads before io_event_init, the events of
+ *        channel with worker option are notified in them, the
+ *        events of one connection are notified in one worker
+ *        in order, the connection is paused reading when the
+ *        queue of its worker is full, and resumed when half
+ *        of queue is drained. a connection closed meanwhile is
+ *        released after its queued events are notified
+ * input: worker_count, number of worker threads, 0 no worker
+ *        queue_len, max queued events of one worker, 0 NET_WORKER_QUEUE
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_set_worker(int worker_count, unsigned int queue_len);
+
+/**********************************************************
+ * brief: set resolver before io_event_init, the threads are
+ *        started by the first io_event_resolve, the results are
+ *        cached for ttl, getaddrinfo does not report the ttl of
+ *        dns records
+ * input: thread_count, number of resolver threads, <=0 NET_RESOLVER_THREAD
+ *        ttl, milliseconds of cached result, 0 NET_RESOLVE_TTL
+ *        neg_ttl, milliseconds of cached failure, 0 NET_RESOLVE_NEG_TTL
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_set_resolver(int thread_count, unsigned int ttl, unsigned int neg_ttl);
+
+/**********************************************************
+ * brief: get option of channel, default option if not set
+ * input: channel, id value for different communication
+ *        opt, return channel option
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_get_channel_opt(unsigned short channel, struct io_channel_opt *opt);
+
+/**********************************************************
+ * brief: set option of channel after io_event_init, the handles
+ *        created after it use the option, the handles created
+ *        before keep the old one, which is freed after the last
+ *        of them is released
+ * input: channel, id value for different communication
+ *        opt, channel option
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_set_channel_opt(unsigned short channel, const struct io_channel_opt *opt);
+
+/**********************************************************
+ * brief: create tcp server/connection and monitor it, the
+ *        connecting blocks up to 5 seconds
+ * input: ip, host ip addr or null/empty string
+ *        port, host port
+ *        channel, id value for different communication
+ *
+ * return: NULL error, other ok
+ *********************************************************/
+struct io_handle* io_event_create_tcp(const char *ip, unsigned short port, unsigned short channel);
+
+/**********************************************************
+ * brief: connect to tcp server without blocking, ENT_CONNECT is
+ *        notified when the connection completes, fails or times
+ *        out, the handle is closed after notifying the failure.
+ *        data sent before ENT_CONNECT is queued. with channel
+ *        option connect_fastopen, ENT_CONNECT is notified at once
+ *        and the failure is notified by ENT_CLOSE
+ * input: ip, server ip addr
+ *        port, server port
+ *        channel, id value for different communication
+ *        timeout, milliseconds, ENT_CONNECT with ETIMEDOUT if not
+ *                 connected in it, 0 the timeout of system
+ *
+ * return: NULL error, other ok
+ *********************************************************/
+struct io_handle* io_event_connect_async(const char *ip, unsigned short port, unsigned short channel, unsigned int timeout);
+
+/**********************************************************
+ * brief: resolve host to ipv4 addrs without blocking, pf is
+ *        called in the reactor of hd, or any reactor if hd is
+ *        NULL, even the result is cached. resolving of one host
+ *        is shared by the concurrent requests of it
+ * input: host, domain string, /etc/hosts is used as configured
+ *        hd, io_handle, NULL any reactor
+ *        pf, resolving callback function
+ *        arg, param for pf
+ *
+ * return: -1 error, 0 ok, pf is called once
+ *********************************************************/
+int io_event_resolve(const char *host, struct io_handle *hd, pfunc_resolve_notify pf, void *arg);
+
+/**********************************************************
+ * brief: create pool of connections to tcp server, it connects
+ *        opt->idle_count connections at once and keeps them warm,
+ *        the events of idle connections are handled by the pool,
+ *        the closed or broken ones are refilled by health check
+ * input: ip, server ip addr
+ *        port, server port
+ *        channel, id value for different communication, the pool
+ *                 is keyed by ip, port and channel
+ *        opt, pool option
+ *
+ * return: -1 error or created, 0 ok
+ *********************************************************/
+int io_event_pool_create(const char *ip, unsigned short port, unsigned short channel, const struct io_pool_opt *opt);
+
+/**********************************************************
+ * brief: get connection from pool, an idle connected one if any,
+ *        otherwise a new one by io_event_connect_async, return it
+ *        by io_event_pool_put or close it when done, the handle is
+ *        not released before that even it is closed by peer
+ * input: ip, server ip addr
+ *        port, server port
+ *        channel, id value for different communication
+ *        connected, 1 returned if the connection is connected, 0
+ *                   ENT_CONNECT will be notified
+ *
+ * return: NULL error or no pool, other ok
+ *********************************************************/
+struct io_handle* io_event_pool_get(const char *ip, unsigned short port, unsigned short channel, int *connected);
+
+/**********************************************************
+ * brief: return connection to its pool, it is kept idle if the
+ *        pool is not full and nothing is pending on it, otherwise
+ *        closed, the handle must not be used after it
+ * input: hd, io_handle from io_event_pool_get
+ *
+ * return: None
+ *********************************************************/
+void io_event_pool_put(struct io_handle *hd);
+
+/**********************************************************
+ * brief: create udp server/connection and monitor it
+ * input: ip, host ip addr or null/empty string
+ *        port, host port
+ *        channel, id value for different communication
+ *
+ * return: NULL error, other ok
+ *********************************************************/
+struct io_handle* io_event_create_udp(const char *ip, unsigned short port, unsigned short channel);
+
+/**********************************************************
+ * brief: close io_handle and not to monitor it, the handle is
+ *        released by the next loop of its reactor, closing it
+ *        again or sending on it before that is ignored/failed
+ * input: hd, io_handle
+ *
+ * return: None
+ *********************************************************/
+void io_event_close_handle(struct io_handle *hd);
+
+/**********************************************************
+ * brief: get id of io_handle, the id is packed by the slot of
+ *        handle and its generation, so it is not reused by the
+ *        later handles, io_event_send_id/io_event_close_id with
+ *        it are safe in any thread after the handle is closed
+ * input: hd, tcp/udp io_handle, not udp session
+ *
+ * return: 0 error, other ok
+ *********************************************************/
+unsigned long long io_event_handle_id(const struct io_handle *hd);
+
+/**********************************************************
+ * brief: send data on io_handle of id, same as io_event_send_data
+ * input: id, id from io_event_handle_id
+ *        data, will be sent data
+ *        len, data len
+ *
+ * return: -1 error or handle closed, >=0 actually len send data
+ *********************************************************/
+int io_event_send_id(unsigned long long id, const char *data, int len);
+
+/**********************************************************
+ * brief: close io_handle of id, same as io_event_close_handle
+ * input: id, id from io_event_handle_id
+ *
+ * return: -1 handle has been closed, 0 ok
+ *********************************************************/
+int io_event_close_id(unsigned long long id);
+
+/**********************************************************
+ * brief: pause reading of tcp connection, the socket is not read
+ *        and the kernel buffer fills, so tcp window throttles the
+ *        peer, the complete frames not notified yet are kept
+ * input: hd, tcp connection io_handle
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_pause_read(struct io_handle *hd);
+
+/**********************************************************
+ * brief: resume reading paused by io_event_pause_read or by
+ *        recv_high_watermark, the pending data is notified
+ *        again by reactor
+ * input: hd, tcp connection io_handle
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_resume_read(struct io_handle *hd);
+
+/**********************************************************
+ * brief: post data to the reactor of io_handle, the reactor sends
+ *        it in next loop, the posted data of one handle is sent
+ *        in order and batched to one writev, it is lock-free
+ *        and used by the threads other than reactor
+ * input: id, id from io_event_handle_id
+ *        data, will be sent data, copied
+ *        len, data len
+ *
+ * return: -1 error, 0 ok, the data is dropped if handle is closed
+ *         before sending
+ *********************************************************/
+int io_event_post_send(unsigned long long id, const char *data, int len);
+
+/**********************************************************
+ * brief: post closing to the reactor of io_handle, the handle is
+ *        closed after the data posted before
+ * input: id, id from io_event_handle_id
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_post_close(unsigned long long id);
+
+/**********************************************************
+ * brief: post task to the reactor of io_handle, pf is called in
+ *        the reactor thread even if the handle has been closed
+ * input: id, id from io_event_handle_id
+ *        pf, task function
+ *        arg, param for pf
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_post_task(unsigned long long id, pfunc_reactor_task pf, void *arg);
+
+/**********************************************************
+ * brief: send data on io_handle hd, the tcp data can not be
+ *        sent at once is queued and sent when writable
+ * input: hd, io handle
+ *        data, will send data
+ *        len, data len
+ *
+ * return: -1 error, >=0 actually len send or queued data
+ *********************************************************/
+int io_event_send_data(struct io_handle *hd, const char *data, int len);
+
+/**********************************************************
+ * brief: gather send data on io_handle hd without copying them
+ *        together, the tcp data can not be sent at once is
+ *        queued and sent when writable, all data of udp is
+ *        sent as one datagram
+ * input: hd, io handle
+ *        iov, buffers of will send data
+ *        cnt, count of iov
+ *
+ * return: -1 error, >=0 actually len send or queued data
+ *********************************************************/
+int io_event_send_datav(struct io_handle *hd, const struct iovec *iov, int cnt);
+
+/**********************************************************
+ * brief: send many datagrams on udp io_handle hd by batch,
+ *        datagrams of same size to same peer are sent by
+ *        udp gso if supported
+ * input: hd, io handle of udp
+ *        msgs, datagrams, buf/len/addr are used, sin_family
+ *              of addr 0 for the connected peer
+ *        cnt, count of msgs
+ *
+ * return: -1 error, >=0 count of sent datagrams, the left are
+ *         dropped if socket send buffer is full
+ *********************************************************/
+int io_event_send_udp_batch(struct io_handle *hd, const struct udp_msg *msgs, int cnt);
+
+/**********************************************************
+ * brief: send datagram to the peer addr on udp io_handle hd,
+ *        such as replying to nd->addr of ENT_DATA
+ * input: hd, io handle of udp
+ *        addr, peer address, struct sockaddr_in
+ *        data, will send data
+ *        len, data len
+ *
+ * return: -1 error, >=0 actually len send data
+ *********************************************************/
+int io_event_send_udp_to(struct io_handle *hd, const struct sockaddr *addr, const char *data, int len);
+
+/**********************************************************
+ * brief: enable peer sessions of udp server, a session io_handle
+ *        sharing the server socket is created for every new peer
+ *        and notified by ENT_ACCEPT, the datagrams of the peer are
+ *        notified by ENT_DATA with it, io_event_send_data on it
+ *        replies to the peer. the session is closed after idle
+ *        timeout with ENT_CLOSE, or by io_event_close_handle
+ * input: hd, io handle of udp server
+ *        size, hash size of session table, such as peer count
+ *        idle_timeout, milliseconds, 0 never expire
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_set_udp_session(struct io_handle *hd, unsigned int size, unsigned int idle_timeout);
+
+/**********************************************************
+ * brief: add timer driven by reactor loop
+ * input: hd, the timer is driven by the reactor of hd,
+ *            so pf runs in the same thread with hd events,
+ *            NULL any reactor
+ *        timeout, milliseconds from now to the first expire
+ *        interval, milliseconds of period, 0 only once
+ *        pf, timer notify callback function
+ *        arg, param for pf
+ *
+ * return: NULL error, other ok, the timer is valid until
+ *         io_event_timer_cancel even it has expired
+ *********************************************************/
+struct io_timer* io_event_timer_add(struct io_handle *hd, unsigned int timeout, unsigned int interval, pfunc_timer_notify pf, void *arg);
+
+/**********************************************************
+ * brief: restart timer with new timeout, can be called in pf
+ * input: timer, timer from io_event_timer_add
+ *        timeout, milliseconds from now to the next expire
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_timer_rearm(struct io_timer *timer, unsigned int timeout);
+
+/**********************************************************
+ * brief: cancel and free timer, can be called in pf
+ * input: timer, timer from io_event_timer_add
+ *
+ * return: None
+ *********************************************************/
+void io_event_timer_cancel(struct io_timer *timer);
+
+/**********************************************************
+ * brief: close io_handle if no data is received or sent on it
+ *        in timeout, ENT_CLOSE is notified before closing
+ * input: hd, io handle
+ *        timeout, milliseconds, 0 disable
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_set_idle_timeout(struct io_handle *hd, unsigned int timeout);
+
+/**********************************************************
+ * brief: enable zerocopy send on tcp io_handle, linux only,
+ *        the data of io_event_send_data not less than threshold
+ *        is sent without copying and must be kept until
+ *        ENT_SEND_DONE, or ENT_CLOSE/io_event_close_handle,
+ *        less data is copied as usual. after the kernel reports
+ *        copying, such as on loopback, the data not less than
+ *        threshold is copied and ENT_SEND_DONE is still notified
+ * input: hd, io handle of tcp connection
+ *        threshold, bytes, 0 disable, NET_ZEROCOPY_THRESHOLD suggested
+ *
+ * return: -1 error or not supported, 0 ok
+ *********************************************************/
+int io_event_set_zerocopy(struct io_handle *hd, unsigned int threshold);
+
+/**********************************************************
+ * brief: enable/disable udp gro receiving on udp io_handle,
+ *        linux only, datagrams from same peer are coalesced
+ *        by kernel and received by one call, then they are
+ *        split and notified one by one as before
+ * input: hd, io handle of udp
+ *        enable, 1 enable, 0 disable
+ *
+ * return: -1 error or not supported, 0 ok
+ *********************************************************/
+int io_event_set_udp_gro(struct io_handle *hd, int enable);
+
+/**********************************************************
+ * brief: start threads for monitor io event, one per reactor
+ * input: None
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int io_event_run();
+
+/**********************************************************
+ * brief: stop threads that monitoring io event
+ * input: None
+ *
+ * return: None
+ *********************************************************/
+void io_event_stop();
+
+/**********************************************************
+ * brief: release io_event env
+ * input: None
+ *
+ * return: None
+ *********************************************************/
+void io_event_release();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//_IO_EVENT_H_
+
@@ -1,286 +1,1564 @@
-#include "io_event_api.h"
-#include "mem_pool.h"
-#include "log.h"
-#include "net_error.h"
-#include "typedef.h"
-
-#ifdef _WIN32
-  #include <Windows.h>
-#else
-  #include <errno.h>
-  #include <unistd.h>
-  #include <linux/types.h>
-  #include <sys/epoll.h>
-  #ifndef EPOLLONESHOT
-    /*for NDK-buidl*/
-    #ifdef __CHECK_POLL
-       typedef unsigned __bitwise __poll_t;
-    #else
-       typedef unsigned __poll_t;
-    #endif
-    /* Set the One Shot behaviour for the target file descriptor */
-    #define EPOLLONESHOT (__force __poll_t)(1U << 30)
-  #endif
-#endif //_WIN32
-
-//io event object define
-//count, current actived io count
-//size, total io count
-//handle, io handle
-struct io_event {
-	int count;
-	int size;
-	int stop;
-	long handle;
-};
-
-struct io_event* io_event_create(int size)
-{
-	struct io_event *ie;
-#ifdef _WIN32
-	HANDLE hIOCP;
-#else
-	int efd;
-#endif //_WIN32
-
-	if(size <= 0) {
-		LOG_WARN("[io_event_api] io_event_create failed, size is 0.");
-		return NULL;
-	}
-	
-	ie = (struct io_event*)mem_pool_malloc(sizeof(struct io_event));
-	if(NULL==ie) {
-		LOG_WARN("[io_event_api] io_event_create failed, mem_pool_malloc failed.");
-		return NULL;
-	} else {
-		ie->count = 0;
-		ie->size = size;
-		ie->stop = 0;
-	}
-
-#ifdef _WIN32
-	//HANDLE WINAPI CreateIoCompletionPort(
-	//	_In_     HANDLE    FileHandle,
-	//	_In_opt_ HANDLE    ExistingCompletionPort,
-	//	_In_     ULONG_PTR CompletionKey,
-	//	_In_     DWORD     NumberOfConcurrentThreads
-	//);
-	hIOCP = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 0);
-	if(NULL==hIOCP) {
-		mem_pool_free(ie);
-		LOG_WARN("[io_event_api] io_event_create failed, crate iocp failed.");
-		return NULL;
-	} else {
-		ie->handle = (long)hIOCP;
-	}
-#else
-	//count is not the maximum size of the backing store
-	//Nowadays, size is ignored, Since Linux 2.6.8, the size argument is unused.
-	efd = epoll_create(size);
-	if(-1==efd) {
-		mem_pool_free(ie);
-		LOG_WARN("[io_event_api] io_event_create failed, crate epoll failed.");
-		return NULL;
-	} 
-	else {
-		ie->handle = (long)efd;
-	}
-#endif //_WIN32
-
-	return ie;
-}
-
-int io_event_loop(struct io_event *ie, pfunc_io_event_notify pf)
-{
-	struct io_handle *hd;
-#ifdef _WIN32
-	DWORD bytes;
-	LPOVERLAPPED pol;
-#else
-	#define MAX_EVENTS (20)
-	struct epoll_event ev, evs[MAX_EVENTS];
-	int nfds, i;
-#endif //_WIN32
-
-	if(NULL==ie || NULL==pf) {
-		LOG_WARN("[io_event_api] event loop failed, param is invalid.");
-		return -1;
-	}
-
-	//loop for monitoring
-	while(1) {
-		if(ie->stop) {
-			break;
-		}
-#ifdef _WIN32
-		/*BOOL WINAPI GetQueuedCompletionStatus(
-		_In_  HANDLE       CompletionPort,
-		_Out_ LPDWORD      lpNumberOfBytes,
-		_Out_ PULONG_PTR   lpCompletionKey,
-		_Out_ LPOVERLAPPED *lpOverlapped,
-		_In_  DWORD        dwMilliseconds
-		);*/
-		if(TRUE==GetQueuedCompletionStatus((HANDLE)ie->handle, 
-			(LPDWORD)&bytes, (LPDWORD)&hd,
-			&pol,
-			INFINITE)) {
-			if(0==bytes) {
-				//client be closed
-				pf(ie, hd, bytes, pol);
-			} else {
-				//handle event
-				pf(ie, hd, bytes, pol);
-			}
-		} else {
-			if(ERROR_ABANDONED_WAIT_0 == GetLastError()) {
-				// the completion port handle was closed while the call is outstanding
-				// pol is null
-				pf(ie, hd, bytes, pol);
-			} else {
-				LOG_WARN("[io_event_api] GetQueuedCompletionStatus failed.");
-			}
-		}
-#else
-		nfds = epoll_wait(ie->handle, evs, /*maxevents*/MAX_EVENTS, /*timeout-milliseconds*/400);
-		if(-1==nfds) {
-			if(EINTR==errno) {
-				//interrupted by highest process such as gdb
-				continue;
-			}
-			//error
-			LOG_WARN("[io_event_api] epoll_wait failed, errno=%d", errno);
-			ie->stop = 1;
-		}
-
-		for(i=0;i<nfds;++i) {
-			hd = (struct io_handle*)evs[i].data.ptr;
-			ev.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
-			ev.data.ptr = hd;
-			pf(ie, hd);
-			if(-1==epoll_ctl(ie->handle, EPOLL_CTL_MOD, hd->s, &ev)) {
-				if(EBADF==errno) {
-					//mayne hd->s have been closed in pf function
-				} else {
-					LOG_WARN("[io_event_api] after handling event at socket=%d, do EPOLL_CTL_MOD failed.", hd->s);
-				}
-			}
-		}
-#endif //_WIN32
-	}
-
-	LOG_WARN("[io_event_api] event loop exit.");
-
-	return 0;
-}
-
-void io_event_stop_loop(struct io_event *ie)
-{
-#ifdef _WIN32
-	OVERLAPPED ol = {0, 0, 0, 0, NULL};
-#endif //_WIN32
-
-	if(ie) {
-		ie->stop = 1;
-#ifdef _WIN32
-		PostQueuedCompletionStatus((HANDLE)ie->handle,
-			NULL, NULL, NULL, &ol);
-#endif //_WIN32
-	}
-}
-
-int io_event_add(struct io_event *ie, struct io_handle *hd)
-{
-	int ret;
-#ifdef _WIN32
-#else
-	struct epoll_event ev;
-#endif //_WIN32
-
-	if(NULL==ie || NULL==hd) {
-		LOG_WARN("[io_event_api] event add failed, param is invalid.");
-		return -1;
-	}
-
-	if(ie->count >= ie->size) {
-		LOG_WARN("[io_event_api] event add failed, io handle count is up to limit=%d.", ie->size);
-		return -1;
-	}
-
-#ifdef _WIN32
-	/*HANDLE WINAPI CreateIoCompletionPort(
-	_In_     HANDLE    FileHandle,
-	_In_opt_ HANDLE    ExistingCompletionPort,
-	_In_     ULONG_PTR CompletionKey,
-	_In_     DWORD     NumberOfConcurrentThreads
-	);*/
-	//The handle s must be to an object that supports overlapped I/O.
-	ret = (NULL==CreateIoCompletionPort((HANDLE)hd->s, (HANDLE)ie->handle, (ULONG_PTR)hd, 0)) ? (-1) : (0);
-#else
-	/*typedef union epoll_data {
-               void        *ptr;
-               int          fd;
-               __uint32_t   u32;
-               __uint64_t   u64;
-           } epoll_data_t;
-
-           struct epoll_event {
-               __uint32_t   events;      * Epoll events *
-               epoll_data_t data;        * User data variable *
-           };
-	*/
-	//EPOLLIN, notify event when readable
-	//EPOLLET, notify event when fd state changed, but the state not include that have data in buffer not be handled
-	//EPOLLONESHOT (since Linux 2.6.2), after an event is pulled out with epoll_wait(2) the associated file descriptor 
-	// is internally disabled and no other events will be  reported. The user must call epoll_ctl() with EPOLL_CTL_MOD 
-	// to re-arm the file descriptor with a new event mask
-	ev.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
-	ev.data.ptr = hd;
-
-	//successful, epoll_ctl() returns zero.
-	//When an error occurs, epoll_ctl() returns -1
-	ret = epoll_ctl(ie->handle, EPOLL_CTL_ADD, hd->s, &ev);
-#endif //_WIN32
-
-	if(0==ret) {
-		ie->count++;
-	}
-	return ret;
-}
-
-int io_event_del(struct io_event *ie, struct io_handle *hd)
-{
-	int ret;
-	struct epoll_event ev;
-
-	if(NULL==ie || NULL==hd) {
-		LOG_WARN("[io_event_api] event del failed, param is invalid.");
-		return -1;
-	}
-
-#ifdef _WIN32
-	if(ie->count > 0) {
-		ret = 0;
-	}
-#else
-	//The event is ignored and can be NULL (but see BUGS below).
-	ret = epoll_ctl(ie->handle, EPOLL_CTL_DEL, hd->s, &ev);
-#endif //_WIN32
-
-	if(0==ret) {
-		ie->count--;
-	}
-	return ret;
-}
-
-void io_event_destroy(struct io_event *ie)
-{
-	if(ie) {
-#ifdef _WIN32
-		CloseHandle((HANDLE)ie->handle);
-#else
-		close((int)ie->handle);
-#endif //_WIN32
-		mem_pool_free(ie);
-	}
-}
-
+#include "io_event_api.h"
+#include "mem_pool.h"
+#include "log.h"
+#include "net_error.h"
+#include "typedef.h"
+#include "uring_api.h"
+#include "thread_lock.h"
+#include "atomic.h"
+#include <string.h>
+
+#ifdef _WIN32
+  #include <Windows.h>
+#else
+  #include <errno.h>
+  #include <unistd.h>
+  #include <linux/types.h>
+  #include <sys/epoll.h>
+  #ifndef EPOLLONESHOT
+    /*for NDK-buidl*/
+    #ifdef __CHECK_POLL
+       typedef unsigned __bitwise __poll_t;
+    #else
+       typedef unsigned __poll_t;
+    #endif
+    /* Set the One Shot behaviour for the target file descriptor */
+    #define EPOLLONESHOT (__force __poll_t)(1U << 30)
+  #endif
+  #include <poll.h>
+  #include <sys/eventfd.h>
+#endif //_WIN32
+
+//io event object define
+//count, current actived io count
+//size, total io count
+//handle, io handle
+//mode, trigger mode
+//wake_fd, eventfd for waking up the loop, registered with data ie
+//hook, loop hook and its param
+//fired, events of one wait in dispatching, the events of deleted handle are dropped
+//uring, io_uring backend, NULL for epoll/iocp
+#ifdef NET_HAVE_URING
+//provided buffers of io_event shared by the receiving handles
+#define URING_BUF_COUNT (256)
+#define URING_BUF_SIZE (8192)
+#define URING_BUF_NONE (0xffff)
+//accepting operations of listening socket
+#define URING_ACCEPT_SLOTS (16)
+struct uring_ctx;
+#endif //NET_HAVE_URING
+struct io_event {
+	int count;
+	int size;
+	int stop;
+	enum EIO_TRIGGER_MODE mode;
+	long handle;
+	pfunc_io_event_hook hook;
+	void *hook_arg;
+#ifndef _WIN32
+	int wake_fd;
+	long volatile wake_pending;
+	struct epoll_event *fired;
+	int fired_cur;   //index of event in dispatching
+	int fired_count;
+#endif //_WIN32
+#ifdef NET_HAVE_URING
+	struct uring_t *uring;
+	struct tlock_t *sq_lock;          //serialize submission queue and states of handles
+	unsigned int ops;                 //IO_OP_xxx supported
+	struct uring_ctx *ctxs;           //states of handles, the detached wait for completions
+	struct uring_ctx *starved;        //receiving stopped by no buffer
+	unsigned int buf_free;            //buffers in ring, not selected by the reaped completions
+	unsigned short buf_next[URING_BUF_COUNT]; //received buffers of handle, linked by id
+	unsigned int buf_len[URING_BUF_COUNT];
+#endif //NET_HAVE_URING
+};
+
+#ifndef _WIN32
+//io_event the current thread is looping on
+static __thread struct io_event *t_loop_ie;
+#endif //_WIN32
+
+#ifdef NET_HAVE_URING
+//kind of io_uring operation of handle
+enum EURING_OP {
+	EUO_POLL = 1,
+	EUO_RECV,
+	EUO_ACCEPT,
+	EUO_KICK      //nop, notify the received before pausing
+};
+//state of accepting operation
+enum EURING_ACCEPT {
+	EUA_FREE = 0,
+	EUA_ARMED,
+	EUA_CANCEL,
+	EUA_DONE,     //completed, got by io_event_accept
+	EUA_FAILED    //error got, armed again by io_event_accept returning -2
+};
+//user_data of operation, state in low 48 bits, accepting index in bits 48-55, kind in bits 56-63
+#define URING_UD(ctx, op, idx) (((unsigned long long)(op)<<56) | ((unsigned long long)(idx)<<48) | (unsigned long long)(unsigned long)(ctx))
+#define URING_UD_CTX(ud) ((struct uring_ctx*)(unsigned long)((ud)&0xffffffffffffULL))
+#define URING_UD_OP(ud) ((int)((ud)>>56))
+#define URING_UD_IDX(ud) ((int)(((ud)>>48)&0xff))
+
+struct uring_accept {
+	int state;   //EUA_xxx
+	int res;     //accepted socket or -errno
+	struct sockaddr_in addr; //written by kernel
+	socklen_t addr_len;
+};
+//state of handle, protected by sq_lock. it is detached by io_event_del and
+//freed after its last operation completes, so the late completions never
+//refer to the deleted handle
+struct uring_ctx {
+	struct io_handle *hd;    //NULL detached
+	unsigned int op;         //IO_OP_xxx
+	unsigned int inflight;   //operations not completed
+	int fired;               //index+1 in events of loop, not freed while dispatching
+	//poll of the events not done by operations
+	int polling;
+	unsigned int poll_mask;  //poll events of armed poll, 0 removing
+	//multishot recv
+	int recving;
+	int recv_cancel;
+	int kicked;
+	int starved;             //armed again when a buffer is given back
+	struct uring_ctx *starved_next;
+	unsigned short buf_head; //received buffers not consumed
+	unsigned short buf_tail;
+	unsigned int buf_off;    //consumed of head buffer
+	char *spill;             //received data moved out of buffers while reading is paused
+	unsigned int spill_len;
+	unsigned int spill_off;
+	int eof;
+	int err;                 //errno of receiving, got after the received data
+	struct uring_ctx *prev;  //in ctxs of io_event
+	struct uring_ctx *next;
+	struct uring_accept accepts[0]; //URING_ACCEPT_SLOTS for IO_OP_ACCEPT
+};
+
+static int io_event_uring_poll_locked(struct io_event *ie, int fd, unsigned int mask, unsigned long long ud, int multishot);
+static int io_event_uring_arm(struct io_event *ie, struct io_handle *hd, unsigned int op, unsigned int events);
+static int io_event_uring_update(struct io_event *ie, struct io_handle *hd, unsigned int events);
+static int io_event_uring_disarm(struct io_event *ie, struct io_handle *hd);
+static int io_event_uring_accept(struct io_event *ie, struct io_handle *hd, SOCKET *c, struct sockaddr_in *addr);
+static int io_event_uring_recv(struct io_event *ie, struct io_handle *hd, char *buf, int len);
+static void io_event_uring_release(struct io_event *ie);
+static int io_event_uring_loop(struct io_event *ie, pfunc_io_event_notify pf);
+#endif //NET_HAVE_URING
+
+#ifndef _WIN32
+//the handle is deleted, maybe freed, by pf, drop its events not dispatched and
+//mark the one in dispatching
+static inline void io_event_drop_fired(struct io_event *ie, const struct io_handle *hd)
+{
+	int i;
+
+	if(t_loop_ie!=ie) {
+		return ;
+	}
+	for(i=ie->fired_cur; i<ie->fired_count; ++i) {
+		if(ie->fired[i].data.ptr==(void*)hd) {
+			ie->fired[i].data.ptr = NULL;
+		}
+	}
+}
+
+static inline void io_event_wake_drain(struct io_event *ie)
+{
+	eventfd_t val;
+	//clear flag first, the later io_event_wakeup will write again
+	atomic_set(&ie->wake_pending, 0);
+	eventfd_read(ie->wake_fd, &val);
+}
+
+static inline unsigned int io_event_trigger_events(enum EIO_TRIGGER_MODE mode, unsigned int events)
+{
+	unsigned int ev = 0;
+
+	if(events&IO_EVENT_READ) {
+		ev |= EPOLLIN;
+	}
+	if(events&IO_EVENT_WRITE) {
+		ev |= EPOLLOUT;
+	}
+
+	switch(mode) {
+		case EITM_EDGE:
+			return ev | EPOLLET;
+		case EITM_LEVEL:
+			return ev;
+		default:
+		//case EITM_ONESHOT:
+			return ev | EPOLLET | EPOLLONESHOT;
+	}
+}
+
+//convert epoll/poll events to IO_EVENT_XXX
+static inline unsigned int io_event_happened_events(unsigned int ev)
+{
+	unsigned int events = 0;
+
+	//error and hang up are handled by reading
+	if(ev&(EPOLLIN|EPOLLERR|EPOLLHUP)) {
+		events |= IO_EVENT_READ;
+	}
+	if(ev&EPOLLERR) {
+		events |= IO_EVENT_ERROR;
+	}
+	if(ev&EPOLLOUT) {
+		events |= IO_EVENT_WRITE;
+	}
+	return events;
+}
+#endif //_WIN32
+
+struct io_event* io_event_create(int size)
+{
+	struct io_event *ie;
+#ifdef _WIN32
+	HANDLE hIOCP;
+#else
+	int efd;
+	struct epoll_event ev;
+#endif //_WIN32
+
+	if(size <= 0) {
+		LOG_WARN("[io_event_api] io_event_create failed, size is 0.");
+		return NULL;
+	}
+	
+	ie = (struct io_event*)mem_pool_malloc(sizeof(struct io_event));
+	if(NULL==ie) {
+		LOG_WARN("[io_event_api] io_event_create failed, mem_pool_malloc failed.");
+		return NULL;
+	} else {
+		ie->count = 0;
+		ie->size = size;
+		ie->stop = 0;
+		ie->mode = EITM_ONESHOT;
+		ie->hook = NULL;
+		ie->hook_arg = NULL;
+#ifdef NET_HAVE_URING
+		ie->uring = NULL;
+		ie->sq_lock = NULL;
+		ie->ops = 0;
+		ie->ctxs = NULL;
+		ie->starved = NULL;
+		ie->buf_free = 0;
+#endif //NET_HAVE_URING
+	}
+
+#ifdef _WIN32
+	//HANDLE WINAPI CreateIoCompletionPort(
+	//	_In_     HANDLE    FileHandle,
+	//	_In_opt_ HANDLE    ExistingCompletionPort,
+	//	_In_     ULONG_PTR CompletionKey,
+	//	_In_     DWORD     NumberOfConcurrentThreads
+	//);
+	hIOCP = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 0);
+	if(NULL==hIOCP) {
+		mem_pool_free(ie);
+		LOG_WARN("[io_event_api] io_event_create failed, crate iocp failed.");
+		return NULL;
+	} else {
+		ie->handle = (long)hIOCP;
+	}
+#else
+	//count is not the maximum size of the backing store
+	//Nowadays, size is ignored, Since Linux 2.6.8, the size argument is unused.
+	efd = epoll_create(size);
+	if(-1==efd) {
+		mem_pool_free(ie);
+		LOG_WARN("[io_event_api] io_event_create failed, crate epoll failed.");
+		return NULL;
+	} 
+	else {
+		ie->handle = (long)efd;
+	}
+
+	ie->fired = NULL;
+	ie->fired_cur = 0;
+	ie->fired_count = 0;
+
+	//the loop waits infinitely, wake it up by eventfd
+	ie->wake_pending = 0;
+	ie->wake_fd = eventfd(0, EFD_NONBLOCK|EFD_CLOEXEC);
+	if(-1==ie->wake_fd) {
+		close(efd);
+		mem_pool_free(ie);
+		LOG_WARN("[io_event_api] io_event_create failed, create eventfd failed.");
+		return NULL;
+	}
+	ev.events = EPOLLIN;
+	ev.data.ptr = ie;
+	if(-1==epoll_ctl(efd, EPOLL_CTL_ADD, ie->wake_fd, &ev)) {
+		close(ie->wake_fd);
+		close(efd);
+		mem_pool_free(ie);
+		LOG_WARN("[io_event_api] io_event_create failed, add eventfd to epoll failed.");
+		return NULL;
+	}
+#endif //_WIN32
+
+	return ie;
+}
+
+struct io_event* io_event_create_uring(int size)
+{
+#ifdef NET_HAVE_URING
+	struct io_event *ie;
+	unsigned int entries = 64;
+
+	if(size <= 0) {
+		LOG_WARN("[io_event_api] io_event_create_uring failed, size is 0.");
+		return NULL;
+	}
+
+	ie = (struct io_event*)mem_pool_malloc(sizeof(struct io_event));
+	if(NULL==ie) {
+		LOG_WARN("[io_event_api] io_event_create_uring failed, mem_pool_malloc failed.");
+		return NULL;
+	}
+	ie->count = 0;
+	ie->size = size;
+	ie->stop = 0;
+	ie->mode = EITM_ONESHOT;
+	ie->handle = -1;
+	ie->hook = NULL;
+	ie->hook_arg = NULL;
+	ie->ops = IO_OP_ACCEPT;
+	ie->ctxs = NULL;
+	ie->starved = NULL;
+	ie->buf_free = 0;
+	ie->fired = NULL;
+	ie->fired_cur = 0;
+	ie->fired_count = 0;
+
+	//every monitored object costs one entry at most between two submissions
+	while(entries<(unsigned int)size && entries<4096) {
+		entries <<= 1;
+	}
+	ie->sq_lock = lock_create_critical_section();
+	if(NULL==ie->sq_lock) {
+		mem_pool_free(ie);
+		LOG_WARN("[io_event_api] io_event_create_uring failed, create lock failed.");
+		return NULL;
+	}
+	ie->uring = uring_create(entries);
+	if(NULL==ie->uring) {
+		lock_destroy(ie->sq_lock);
+		mem_pool_free(ie);
+		LOG_WARN("[io_event_api] io_event_create_uring failed, io_uring is not supported.");
+		return NULL;
+	}
+
+#ifdef NET_HAVE_URING_BUF
+	//receiving by io_uring needs the provided buffers, polled otherwise
+	if(0==uring_buf_create(ie->uring, URING_BUF_COUNT, URING_BUF_SIZE)) {
+		ie->ops |= IO_OP_RECV;
+		ie->buf_free = URING_BUF_COUNT;
+	}
+#endif //NET_HAVE_URING_BUF
+
+	//the loop waits infinitely, wake it up by eventfd
+	ie->wake_pending = 0;
+	ie->wake_fd = eventfd(0, EFD_NONBLOCK|EFD_CLOEXEC);
+	if(-1==ie->wake_fd || -1==io_event_uring_poll_locked(ie, ie->wake_fd, POLLIN, (unsigned long long)(unsigned long)ie, 1)) {
+		if(-1!=ie->wake_fd) {
+			close(ie->wake_fd);
+		}
+		uring_destroy(ie->uring);
+		lock_destroy(ie->sq_lock);
+		mem_pool_free(ie);
+		LOG_WARN("[io_event_api] io_event_create_uring failed, create eventfd failed.");
+		return NULL;
+	}
+
+	return ie;
+#else
+	(void)size;
+	LOG_WARN("[io_event_api] io_event_create_uring failed, io_uring is not supported.");
+	return NULL;
+#endif //NET_HAVE_URING
+}
+
+int io_event_set_trigger(struct io_event *ie, enum EIO_TRIGGER_MODE mode)
+{
+	if(NULL==ie || mode<EITM_ONESHOT || mode>EITM_LEVEL) {
+		LOG_WARN("[io_event_api] set trigger mode failed, param is invalid.");
+		return -1;
+	}
+
+	ie->mode = mode;
+	return 0;
+}
+
+int io_event_set_hook(struct io_event *ie, pfunc_io_event_hook pf, void *arg)
+{
+	if(NULL==ie) {
+		LOG_WARN("[io_event_api] set hook failed, param is invalid.");
+		return -1;
+	}
+
+	ie->hook = pf;
+	ie->hook_arg = arg;
+	return 0;
+}
+
+int io_event_loop(struct io_event *ie, pfunc_io_event_notify pf)
+{
+	struct io_handle *hd;
+	int timeout;
+#ifdef _WIN32
+	DWORD bytes;
+	LPOVERLAPPED pol;
+#else
+	#define MAX_EVENTS (20)
+	struct epoll_event ev, evs[MAX_EVENTS];
+	int nfds, i;
+#endif //_WIN32
+
+	if(NULL==ie || NULL==pf) {
+		LOG_WARN("[io_event_api] event loop failed, param is invalid.");
+		return -1;
+	}
+
+#ifdef NET_HAVE_URING
+	if(ie->uring) {
+		return io_event_uring_loop(ie, pf);
+	}
+#endif //NET_HAVE_URING
+
+#ifndef _WIN32
+	t_loop_ie = ie;
+	ie->fired = evs;
+#endif //_WIN32
+
+	//loop for monitoring
+	while(1) {
+		if(ie->stop) {
+			break;
+		}
+#ifdef _WIN32
+		/*BOOL WINAPI GetQueuedCompletionStatus(
+		_In_  HANDLE       CompletionPort,
+		_Out_ LPDWORD      lpNumberOfBytes,
+		_Out_ PULONG_PTR   lpCompletionKey,
+		_Out_ LPOVERLAPPED *lpOverlapped,
+		_In_  DWORD        dwMilliseconds
+		);*/
+		if(TRUE==GetQueuedCompletionStatus((HANDLE)ie->handle, 
+			(LPDWORD)&bytes, (LPDWORD)&hd,
+			&pol,
+			INFINITE)) {
+			if(0==bytes) {
+				//client be closed
+				pf(ie, hd, bytes, pol);
+			} else {
+				//handle event
+				pf(ie, hd, bytes, pol);
+			}
+		} else {
+			if(ERROR_ABANDONED_WAIT_0 == GetLastError()) {
+				// the completion port handle was closed while the call is outstanding
+				// pol is null
+				pf(ie, hd, bytes, pol);
+			} else {
+				LOG_WARN("[io_event_api] GetQueuedCompletionStatus failed.");
+			}
+		}
+#else
+		//block until io event, io_event_wakeup or the time hook asked for
+		timeout = (ie->hook) ? ie->hook(ie, ie->hook_arg) : -1;
+		if(ie->stop) {
+			break;
+		}
+		nfds = epoll_wait(ie->handle, evs, /*maxevents*/MAX_EVENTS, /*timeout-milliseconds*/timeout);
+		if(-1==nfds) {
+			if(EINTR==errno) {
+				//interrupted by highest process such as gdb
+				continue;
+			}
+			//error
+			LOG_WARN("[io_event_api] epoll_wait failed, errno=%d", errno);
+			ie->stop = 1;
+		}
+
+		ie->fired_count = (nfds>0) ? (nfds) : (0);
+		for(i=0;i<nfds;++i) {
+			ie->fired_cur = i;
+			if(NULL==evs[i].data.ptr) {
+				//handle deleted by former pf
+				continue;
+			}
+			if(evs[i].data.ptr==(void*)ie) {
+				io_event_wake_drain(ie);
+				continue;
+			}
+			hd = (struct io_handle*)evs[i].data.ptr;
+			pf(ie, hd, io_event_happened_events(evs[i].events));
+			if(EITM_ONESHOT!=ie->mode || NULL==evs[i].data.ptr) {
+				//still armed or deleted by pf, no need to re-arm
+				continue;
+			}
+			if(0==hd->events) {
+				//nothing is monitored, hang up would be reported at once,
+				//re-armed by io_event_mod
+				continue;
+			}
+			ev.events = io_event_trigger_events(EITM_ONESHOT, hd->events);
+			ev.data.ptr = hd;
+			if(-1==epoll_ctl(ie->handle, EPOLL_CTL_MOD, hd->s, &ev)) {
+				if(EBADF==errno) {
+					//mayne hd->s have been closed in pf function
+				} else {
+					LOG_WARN("[io_event_api] after handling event at socket=%d, do EPOLL_CTL_MOD failed.", hd->s);
+				}
+			}
+		}
+		ie->fired_count = 0;
+#endif //_WIN32
+	}
+
+#ifndef _WIN32
+	ie->fired = NULL;
+	t_loop_ie = NULL;
+#endif //_WIN32
+	LOG_WARN("[io_event_api] event loop exit.");
+
+	return 0;
+}
+
+void io_event_stop_loop(struct io_event *ie)
+{
+	if(ie) {
+		ie->stop = 1;
+		io_event_wakeup(ie);
+	}
+}
+
+void io_event_wakeup(struct io_event *ie)
+{
+#ifdef _WIN32
+	OVERLAPPED ol = {0, 0, 0, 0, NULL};
+#endif //_WIN32
+
+	if(ie) {
+#ifdef _WIN32
+		PostQueuedCompletionStatus((HANDLE)ie->handle,
+			NULL, NULL, NULL, &ol);
+#else
+		//only the first wakeup before the loop drains it costs a syscall
+		if(0==atomic_compare_set(&ie->wake_pending, 0, 1)) {
+			eventfd_write(ie->wake_fd, 1);
+		}
+#endif //_WIN32
+	}
+}
+
+int io_event_add(struct io_event *ie, struct io_handle *hd)
+{
+	return io_event_add_ex(ie, hd, 0, IO_EVENT_READ);
+}
+
+int io_event_add_ex(struct io_event *ie, struct io_handle *hd, unsigned int op, unsigned int events)
+{
+	int ret;
+#ifdef _WIN32
+#else
+	struct epoll_event ev;
+#endif //_WIN32
+
+	if(NULL==ie || NULL==hd) {
+		LOG_WARN("[io_event_api] event add failed, param is invalid.");
+		return -1;
+	}
+
+	if(ie->count >= ie->size) {
+		LOG_WARN("[io_event_api] event add failed, io handle count is up to limit=%d.", ie->size);
+		return -1;
+	}
+
+#ifdef NET_HAVE_URING
+	if(ie->uring) {
+		ret = io_event_uring_arm(ie, hd, op, events);
+		if(0==ret) {
+			ie->count++;
+		}
+		return ret;
+	}
+#endif //NET_HAVE_URING
+	//use variable only for compiler
+	(void)op;
+	hd->events = events;
+
+#ifdef _WIN32
+	/*HANDLE WINAPI CreateIoCompletionPort(
+	_In_     HANDLE    FileHandle,
+	_In_opt_ HANDLE    ExistingCompletionPort,
+	_In_     ULONG_PTR CompletionKey,
+	_In_     DWORD     NumberOfConcurrentThreads
+	);*/
+	//The handle s must be to an object that supports overlapped I/O.
+	ret = (NULL==CreateIoCompletionPort((HANDLE)hd->s, (HANDLE)ie->handle, (ULONG_PTR)hd, 0)) ? (-1) : (0);
+#else
+	/*typedef union epoll_data {
+               void        *ptr;
+               int          fd;
+               __uint32_t   u32;
+               __uint64_t   u64;
+           } epoll_data_t;
+
+           struct epoll_event {
+               __uint32_t   events;      * Epoll events *
+               epoll_data_t data;        * User data variable *
+           };
+	*/
+	//EPOLLIN, notify event when readable
+	//EPOLLET, notify event when fd state changed, but the state not include that have data in buffer not be handled
+	//EPOLLONESHOT (since Linux 2.6.2), after an event is pulled out with epoll_wait(2) the associated file descriptor 
+	// is internally disabled and no other events will be  reported. The user must call epoll_ctl() with EPOLL_CTL_MOD 
+	// to re-arm the file descriptor with a new event mask
+	ev.events = io_event_trigger_events(ie->mode, hd->events);
+	ev.data.ptr = hd;
+
+	//successful, epoll_ctl() returns zero.
+	//When an error occurs, epoll_ctl() returns -1
+	ret = epoll_ctl(ie->handle, EPOLL_CTL_ADD, hd->s, &ev);
+#endif //_WIN32
+
+	if(0==ret) {
+		ie->count++;
+	}
+	return ret;
+}
+
+int io_event_mod(struct io_event *ie, struct io_handle *hd, unsigned int events)
+{
+#ifdef _WIN32
+#else
+	struct epoll_event ev;
+#endif //_WIN32
+
+	if(NULL==ie || NULL==hd) {
+		LOG_WARN("[io_event_api] event mod failed, param is invalid.");
+		return -1;
+	}
+
+#ifdef NET_HAVE_URING
+	if(ie->uring) {
+		return io_event_uring_update(ie, hd, events);
+	}
+#endif //NET_HAVE_URING
+
+	if(hd->events==events) {
+		return 0;
+	}
+	hd->events = events;
+
+#ifdef _WIN32
+	return 0;
+#else
+	ev.events = io_event_trigger_events(ie->mode, hd->events);
+	ev.data.ptr = hd;
+	return epoll_ctl(ie->handle, EPOLL_CTL_MOD, hd->s, &ev);
+#endif //_WIN32
+}
+
+int io_event_del(struct io_event *ie, struct io_handle *hd)
+{
+	int ret;
+	struct epoll_event ev;
+
+	if(NULL==ie || NULL==hd) {
+		LOG_WARN("[io_event_api] event del failed, param is invalid.");
+		return -1;
+	}
+
+#ifndef _WIN32
+	io_event_drop_fired(ie, hd);
+#endif //_WIN32
+
+#ifdef NET_HAVE_URING
+	if(ie->uring) {
+		ret = io_event_uring_disarm(ie, hd);
+		if(0==ret) {
+			ie->count--;
+		}
+		return ret;
+	}
+#endif //NET_HAVE_URING
+
+#ifdef _WIN32
+	if(ie->count > 0) {
+		ret = 0;
+	}
+#else
+	//The event is ignored and can be NULL (but see BUGS below).
+	ret = epoll_ctl(ie->handle, EPOLL_CTL_DEL, hd->s, &ev);
+#endif //_WIN32
+
+	if(0==ret) {
+		ie->count--;
+	}
+	return ret;
+}
+
+void io_event_forget(struct io_event *ie, struct io_handle *hd)
+{
+	if(NULL==ie || NULL==hd) {
+		return ;
+	}
+
+#ifndef _WIN32
+	io_event_drop_fired(ie, hd);
+#endif //_WIN32
+
+}
+
+int io_event_accept(struct io_event *ie, struct io_handle *hd, SOCKET *c, struct sockaddr_in *addr)
+{
+	if(NULL==ie || NULL==hd) {
+		LOG_WARN("[io_event_api] event accept failed, param is invalid.");
+		return -1;
+	}
+
+#ifdef NET_HAVE_URING
+	if(ie->uring) {
+		return io_event_uring_accept(ie, hd, c, addr);
+	}
+#endif //NET_HAVE_URING
+
+	return socket_accept_nonblock(hd->s, c, addr);
+}
+
+int io_event_recv(struct io_event *ie, struct io_handle *hd, char *buf, int len)
+{
+	if(NULL==ie || NULL==hd) {
+		LOG_WARN("[io_event_api] event recv failed, param is invalid.");
+		return -1;
+	}
+
+#ifdef NET_HAVE_URING
+	if(ie->uring) {
+		return io_event_uring_recv(ie, hd, buf, len);
+	}
+#endif //NET_HAVE_URING
+
+	return socket_recv_tcp(hd->s, buf, len);
+}
+
+void io_event_destroy(struct io_event *ie)
+{
+	if(ie) {
+#ifdef NET_HAVE_URING
+		if(ie->uring) {
+			io_event_uring_release(ie);
+			uring_destroy(ie->uring);
+			lock_destroy(ie->sq_lock);
+			close(ie->wake_fd);
+			mem_pool_free(ie);
+			return ;
+		}
+#endif //NET_HAVE_URING
+#ifdef _WIN32
+		CloseHandle((HANDLE)ie->handle);
+#else
+		close((int)ie->handle);
+		close(ie->wake_fd);
+#endif //_WIN32
+		mem_pool_free(ie);
+	}
+}
+
+
+
+
+#ifdef NET_HAVE_URING
+static inline struct io_uring_sqe* io_event_uring_get_sqe(struct io_event *ie)
+{
+	struct io_uring_sqe *sqe = uring_get_sqe(ie->uring);
+	if(NULL==sqe) {
+		//submission queue is full, submit them at once
+		uring_submit(ie->uring);
+		sqe = uring_get_sqe(ie->uring);
+	}
+	return sqe;
+}
+
+//not in loop thread, the loop may be waiting, so submit now.
+//in loop thread, it is batched with the next wait
+static inline void io_event_uring_flush_locked(struct io_event *ie)
+{
+	if(t_loop_ie!=ie) {
+		uring_submit(ie->uring);
+	}
+}
+
+static int io_event_uring_poll_locked(struct io_event *ie, int fd, unsigned int mask, unsigned long long ud, int multishot)
+{
+	struct io_uring_sqe *sqe;
+
+	sqe = io_event_uring_get_sqe(ie);
+	if(NULL==sqe) {
+		LOG_WARN("[io_event_api] uring poll fd=%d failed, no sqe.", fd);
+		return -1;
+	}
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = fd;
+	//EPOLLIN/EPOLLOUT/EPOLLERR have the same value with POLLIN/POLLOUT/POLLERR
+	sqe->poll32_events = mask;
+	sqe->len = multishot ? IORING_POLL_ADD_MULTI : 0;
+	sqe->user_data = ud;
+	io_event_uring_flush_locked(ie);
+
+	return 0;
+}
+
+static int io_event_uring_cancel_locked(struct io_event *ie, unsigned long long ud)
+{
+	struct io_uring_sqe *sqe;
+
+	sqe = io_event_uring_get_sqe(ie);
+	if(NULL==sqe) {
+		LOG_WARN("[io_event_api] uring cancel operation failed, no sqe.");
+		return -1;
+	}
+	//the cancelled completes with -ECANCELED
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = -1;
+	sqe->addr = ud;
+	sqe->user_data = 0;
+
+	return 0;
+}
+
+#ifdef NET_HAVE_URING_BUF
+static void io_event_uring_recv_arm_locked(struct io_event *ie, struct uring_ctx *ctx)
+{
+	struct io_uring_sqe *sqe;
+
+	sqe = io_event_uring_get_sqe(ie);
+	if(NULL==sqe) {
+		LOG_WARN("[io_event_api] uring recv socket=%d failed, no sqe.", ctx->hd->s);
+		return ;
+	}
+	//one buffer is selected for every completion until the socket is closed,
+	//so the idle socket holds no buffer
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = ctx->hd->s;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = 0;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->user_data = URING_UD(ctx, EUO_RECV, 0);
+	ctx->recving = 1;
+	++ctx->inflight;
+}
+#endif //NET_HAVE_URING_BUF
+
+static void io_event_uring_accept_arm_locked(struct io_event *ie, struct uring_ctx *ctx, int idx)
+{
+	struct io_uring_sqe *sqe;
+	struct uring_accept *acc = &ctx->accepts[idx];
+
+	sqe = io_event_uring_get_sqe(ie);
+	if(NULL==sqe) {
+		LOG_WARN("[io_event_api] uring accept socket=%d failed, no sqe.", ctx->hd->s);
+		return ;
+	}
+	acc->addr_len = sizeof(struct sockaddr_in);
+	sqe->opcode = IORING_OP_ACCEPT;
+	sqe->fd = ctx->hd->s;
+	sqe->addr = (unsigned long long)(unsigned long)&acc->addr;
+	sqe->addr2 = (unsigned long long)(unsigned long)&acc->addr_len;
+	sqe->accept_flags = SOCK_NONBLOCK|SOCK_CLOEXEC;
+	sqe->user_data = URING_UD(ctx, EUO_ACCEPT, idx);
+	acc->state = EUA_ARMED;
+	++ctx->inflight;
+}
+
+//notify handle by loop without io, such as the data received before pausing
+static void io_event_uring_kick_locked(struct io_event *ie, struct uring_ctx *ctx)
+{
+	struct io_uring_sqe *sqe;
+
+	if(ctx->kicked) {
+		return ;
+	}
+	sqe = io_event_uring_get_sqe(ie);
+	if(NULL==sqe) {
+		LOG_WARN("[io_event_api] uring notify socket=%d failed, no sqe.", ctx->hd->s);
+		return ;
+	}
+	sqe->opcode = IORING_OP_NOP;
+	sqe->user_data = URING_UD(ctx, EUO_KICK, 0);
+	ctx->kicked = 1;
+	++ctx->inflight;
+}
+
+//received or accepted not got by handle
+static inline int io_event_uring_pending_locked(struct uring_ctx *ctx)
+{
+	int i;
+
+	if(ctx->spill || URING_BUF_NONE!=ctx->buf_head || ctx->eof || ctx->err) {
+		return 1;
+	}
+	if(ctx->op&IO_OP_ACCEPT) {
+		for(i=0; i<URING_ACCEPT_SLOTS; ++i) {
+			if(EUA_DONE==ctx->accepts[i].state) {
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+#ifdef NET_HAVE_URING_BUF
+//give buffer back, the receiving stopped by no buffer goes on
+static void io_event_uring_buf_put_locked(struct io_event *ie, unsigned short bid)
+{
+	struct uring_ctx *ctx, *starved;
+
+	uring_buf_put(ie->uring, bid);
+	++ie->buf_free;
+
+	starved = ie->starved;
+	ie->starved = NULL;
+	while(NULL != (ctx = starved)) {
+		starved = ctx->starved_next;
+		ctx->starved_next = NULL;
+		ctx->starved = 0;
+		if(ctx->hd && (ctx->hd->events&IO_EVENT_READ) && !ctx->recving && !ctx->eof && !ctx->err) {
+			io_event_uring_recv_arm_locked(ie, ctx);
+		}
+	}
+}
+
+//move the received buffers into spill while reading is paused, so the
+//buffers are not held by the paused handle
+static void io_event_uring_spill_locked(struct io_event *ie, struct uring_ctx *ctx)
+{
+	unsigned int len, off;
+	unsigned short bid;
+	char *spill;
+
+	len = ctx->spill_len - ctx->spill_off;
+	for(bid=ctx->buf_head; URING_BUF_NONE!=bid; bid=ie->buf_next[bid]) {
+		len += ie->buf_len[bid];
+	}
+	len -= ctx->buf_off;
+	spill = (char*)mem_pool_malloc(len);
+	if(NULL==spill) {
+		//kept in buffers until resuming
+		LOG_WARN("[io_event_api] uring keep received data len=%u of socket=%d failed, mem_pool_malloc failed.", len, ctx->hd->s);
+		return ;
+	}
+
+	off = ctx->spill_len - ctx->spill_off;
+	if(ctx->spill) {
+		memcpy(spill, ctx->spill+ctx->spill_off, off);
+		mem_pool_free(ctx->spill);
+	}
+	while(URING_BUF_NONE != (bid = ctx->buf_head)) {
+		ctx->buf_head = ie->buf_next[bid];
+		memcpy(spill+off, uring_buf_addr(ie->uring, bid)+ctx->buf_off, ie->buf_len[bid]-ctx->buf_off);
+		off += ie->buf_len[bid]-ctx->buf_off;
+		ctx->buf_off = 0;
+		io_event_uring_buf_put_locked(ie, bid);
+	}
+	ctx->buf_tail = URING_BUF_NONE;
+	ctx->spill = spill;
+	ctx->spill_len = len;
+	ctx->spill_off = 0;
+}
+#endif //NET_HAVE_URING_BUF
+
+//arm or cancel the operations and poll by the monitored events of handle
+static void io_event_uring_sync_locked(struct io_event *ie, struct uring_ctx *ctx)
+{
+	int i;
+	unsigned int mask;
+	struct io_handle *hd = ctx->hd;
+	struct io_uring_sqe *sqe;
+
+	if(NULL==hd) {
+		return ;
+	}
+
+	if(ctx->op&IO_OP_RECV) {
+#ifdef NET_HAVE_URING_BUF
+		if(hd->events&IO_EVENT_READ) {
+			if(!ctx->recving && !ctx->starved && !ctx->eof && !ctx->err) {
+				io_event_uring_recv_arm_locked(ie, ctx);
+			}
+		} else {
+			//paused, the socket buffer fills and tcp window throttles the peer
+			if(ctx->recving && !ctx->recv_cancel && 0==io_event_uring_cancel_locked(ie, URING_UD(ctx, EUO_RECV, 0))) {
+				ctx->recv_cancel = 1;
+			}
+			if(URING_BUF_NONE!=ctx->buf_head) {
+				io_event_uring_spill_locked(ie, ctx);
+			}
+		}
+#endif //NET_HAVE_URING_BUF
+		//the errors, such as zerocopy completions in error queue, and writable are polled
+		mask = (hd->events&(IO_EVENT_READ|IO_EVENT_WRITE)) ? (POLLERR | ((hd->events&IO_EVENT_WRITE) ? (POLLOUT) : (0))) : (0);
+	} else if(ctx->op&IO_OP_ACCEPT) {
+		for(i=0; i<URING_ACCEPT_SLOTS; ++i) {
+			if(hd->events&IO_EVENT_READ) {
+				if(EUA_FREE==ctx->accepts[i].state) {
+					io_event_uring_accept_arm_locked(ie, ctx, i);
+				}
+			} else if(EUA_ARMED==ctx->accepts[i].state && 0==io_event_uring_cancel_locked(ie, URING_UD(ctx, EUO_ACCEPT, i))) {
+				ctx->accepts[i].state = EUA_CANCEL;
+			}
+		}
+		mask = (hd->events&IO_EVENT_WRITE) ? (POLLOUT) : (0);
+	} else {
+		mask = io_event_trigger_events(EITM_LEVEL, hd->events);
+	}
+
+	//poll checks the current readiness when armed, so oneshot poll re-armed
+	//after every event acts as level trigger, multishot poll as edge trigger
+	if(!ctx->polling) {
+		//nothing is monitored, such as paused reading, hang up would complete
+		//the poll at once
+		if(mask && 0==io_event_uring_poll_locked(ie, hd->s, mask, URING_UD(ctx, EUO_POLL, 0), EITM_EDGE==ie->mode)) {
+			ctx->polling = 1;
+			ctx->poll_mask = mask;
+			++ctx->inflight;
+		}
+		return ;
+	}
+	if(mask==ctx->poll_mask) {
+		return ;
+	}
+	sqe = io_event_uring_get_sqe(ie);
+	if(NULL==sqe) {
+		LOG_WARN("[io_event_api] uring update socket=%d failed, no sqe.", hd->s);
+		return ;
+	}
+	//update the armed poll in place, if it has finished, it is armed again
+	//with new events after its completion
+	sqe->opcode = IORING_OP_POLL_REMOVE;
+	sqe->fd = -1;
+	sqe->addr = URING_UD(ctx, EUO_POLL, 0);
+	if(mask) {
+		sqe->len = IORING_POLL_UPDATE_EVENTS | ((EITM_EDGE==ie->mode) ? IORING_POLL_ADD_MULTI : 0);
+		sqe->poll32_events = mask;
+	}
+	sqe->user_data = 0;
+	ctx->poll_mask = mask;
+}
+
+//free the detached state after its operations are completed
+static void io_event_uring_ctx_free_locked(struct io_event *ie, struct uring_ctx *ctx)
+{
+	if(ctx->hd || ctx->inflight || ctx->fired) {
+		return ;
+	}
+	if(ctx->prev) {
+		ctx->prev->next = ctx->next;
+	} else {
+		ie->ctxs = ctx->next;
+	}
+	if(ctx->next) {
+		ctx->next->prev = ctx->prev;
+	}
+	mem_pool_free(ctx);
+}
+
+//handle the completion of operation
+//return: the io events notified, 0 nothing
+static unsigned int io_event_uring_complete_locked(struct io_event *ie, struct uring_ctx *ctx, int op, int idx, int res, unsigned int flags)
+{
+	unsigned int events = 0;
+	int more = (flags&IORING_CQE_F_MORE) ? (1) : (0);
+	struct uring_accept *acc;
+#ifdef NET_HAVE_URING_BUF
+	unsigned short bid;
+#endif //NET_HAVE_URING_BUF
+
+	switch(op) {
+		case EUO_POLL:
+			if(!more) {
+				ctx->polling = 0;
+			}
+			if(res>0) {
+				events = io_event_happened_events((unsigned int)res);
+			}
+			break;
+#ifdef NET_HAVE_URING_BUF
+		case EUO_RECV:
+			if(flags&IORING_CQE_F_BUFFER) {
+				bid = (unsigned short)(flags>>IORING_CQE_BUFFER_SHIFT);
+				--ie->buf_free;
+				if(res>0 && ctx->hd) {
+					ie->buf_len[bid] = (unsigned int)res;
+					ie->buf_next[bid] = URING_BUF_NONE;
+					if(URING_BUF_NONE==ctx->buf_tail) {
+						ctx->buf_head = bid;
+					} else {
+						ie->buf_next[ctx->buf_tail] = bid;
+					}
+					ctx->buf_tail = bid;
+				} else {
+					io_event_uring_buf_put_locked(ie, bid);
+				}
+			}
+			if(!more) {
+				ctx->recving = 0;
+				ctx->recv_cancel = 0;
+			}
+			if(NULL==ctx->hd) {
+				break;
+			}
+			if(res>0) {
+				events = IO_EVENT_READ;
+			} else if(0==res) {
+				ctx->eof = 1;
+				events = IO_EVENT_READ;
+			} else if(-ENOBUFS==res) {
+				//all buffers are held, armed again when one is given back, or at
+				//once below if given back before this completion is reaped
+				if(0==ie->buf_free) {
+					ctx->starved = 1;
+					ctx->starved_next = ie->starved;
+					ie->starved = ctx;
+				}
+			} else if(-EINVAL==res) {
+				//multishot recv is not supported, poll and recv by caller
+				LOG_WARN("[io_event_api] uring recv socket=%d failed, multishot recv is not supported.", ctx->hd->s);
+				ie->ops &= ~IO_OP_RECV;
+				ctx->op &= ~IO_OP_RECV;
+				events = IO_EVENT_READ;
+			} else if(-ECANCELED!=res) {
+				ctx->err = -res;
+				events = IO_EVENT_READ;
+			}
+			break;
+#endif //NET_HAVE_URING_BUF
+		case EUO_ACCEPT:
+			acc = &ctx->accepts[idx];
+			if(ctx->hd && -ECANCELED!=res) {
+				acc->state = EUA_DONE;
+				acc->res = res;
+				events = IO_EVENT_READ;
+			} else {
+				if(res>=0) {
+					close(res);
+				}
+				acc->state = EUA_FREE;
+			}
+			break;
+		case EUO_KICK:
+			ctx->kicked = 0;
+			events = (ctx->hd) ? (IO_EVENT_READ) : (0);
+			break;
+		default:
+			LOG_WARN("[io_event_api] uring completion of unknown operation=%d.", op);
+			return 0;
+	}
+
+	if(!more) {
+		--ctx->inflight;
+	}
+	if(NULL==ctx->hd) {
+		io_event_uring_ctx_free_locked(ie, ctx);
+		return 0;
+	}
+	if(!more && 0==events && !ctx->fired) {
+		//not notified, arm the finished again with the latest events
+		io_event_uring_sync_locked(ie, ctx);
+	}
+
+	return events;
+}
+
+static int io_event_uring_arm(struct io_event *ie, struct io_handle *hd, unsigned int op, unsigned int events)
+{
+	int i;
+	struct uring_ctx *ctx;
+
+	op &= ie->ops;
+	ctx = (struct uring_ctx*)mem_pool_malloc(sizeof(struct uring_ctx) + ((op&IO_OP_ACCEPT) ? (URING_ACCEPT_SLOTS*sizeof(struct uring_accept)) : (0)));
+	if(NULL==ctx) {
+		LOG_WARN("[io_event_api] uring add socket=%d failed, mem_pool_malloc failed.", hd->s);
+		return -1;
+	}
+	memset(ctx, 0, sizeof(struct uring_ctx));
+	ctx->hd = hd;
+	ctx->op = op;
+	ctx->buf_head = URING_BUF_NONE;
+	ctx->buf_tail = URING_BUF_NONE;
+	if(op&IO_OP_ACCEPT) {
+		for(i=0; i<URING_ACCEPT_SLOTS; ++i) {
+			ctx->accepts[i].state = EUA_FREE;
+		}
+	}
+
+	lock_lock(ie->sq_lock);
+	ctx->next = ie->ctxs;
+	if(ie->ctxs) {
+		ie->ctxs->prev = ctx;
+	}
+	ie->ctxs = ctx;
+	hd->events = events;
+	hd->backend = ctx;
+	io_event_uring_sync_locked(ie, ctx);
+	io_event_uring_flush_locked(ie);
+	lock_unlock(ie->sq_lock);
+
+	return 0;
+}
+
+static int io_event_uring_update(struct io_event *ie, struct io_handle *hd, unsigned int events)
+{
+	unsigned int old;
+	struct uring_ctx *ctx;
+
+	lock_lock(ie->sq_lock);
+	ctx = (struct uring_ctx*)hd->backend;
+	if(NULL==ctx) {
+		lock_unlock(ie->sq_lock);
+		LOG_WARN("[io_event_api] uring update socket=%d failed, not added.", hd->s);
+		return -1;
+	}
+	old = hd->events;
+	if(old==events) {
+		lock_unlock(ie->sq_lock);
+		return 0;
+	}
+	hd->events = events;
+	io_event_uring_sync_locked(ie, ctx);
+	if(0==(old&IO_EVENT_READ) && (events&IO_EVENT_READ) && io_event_uring_pending_locked(ctx)) {
+		//no completion comes for the received before pausing
+		io_event_uring_kick_locked(ie, ctx);
+	}
+	io_event_uring_flush_locked(ie);
+	lock_unlock(ie->sq_lock);
+
+	return 0;
+}
+
+static int io_event_uring_disarm(struct io_event *ie, struct io_handle *hd)
+{
+	int i;
+	unsigned short bid;
+	struct uring_ctx *ctx, **pctx;
+
+	lock_lock(ie->sq_lock);
+	ctx = (struct uring_ctx*)hd->backend;
+	if(NULL==ctx) {
+		lock_unlock(ie->sq_lock);
+		return -1;
+	}
+	hd->backend = NULL;
+	ctx->hd = NULL;
+
+	//the operations hold the file, cancel them before the socket is closed,
+	//their completions are dropped
+	if(ctx->polling) {
+		io_event_uring_cancel_locked(ie, URING_UD(ctx, EUO_POLL, 0));
+	}
+	if(ctx->recving && !ctx->recv_cancel) {
+		io_event_uring_cancel_locked(ie, URING_UD(ctx, EUO_RECV, 0));
+	}
+	if(ctx->op&IO_OP_ACCEPT) {
+		for(i=0; i<URING_ACCEPT_SLOTS; ++i) {
+			if(EUA_ARMED==ctx->accepts[i].state) {
+				io_event_uring_cancel_locked(ie, URING_UD(ctx, EUO_ACCEPT, i));
+			} else if(EUA_DONE==ctx->accepts[i].state && ctx->accepts[i].res>=0) {
+				close(ctx->accepts[i].res);
+			}
+		}
+	}
+	uring_submit(ie->uring);
+
+#ifdef NET_HAVE_URING_BUF
+	while(URING_BUF_NONE != (bid = ctx->buf_head)) {
+		ctx->buf_head = ie->buf_next[bid];
+		io_event_uring_buf_put_locked(ie, bid);
+	}
+#else
+	(void)bid;
+#endif //NET_HAVE_URING_BUF
+	if(ctx->spill) {
+		mem_pool_free(ctx->spill);
+		ctx->spill = NULL;
+	}
+	if(ctx->starved) {
+		for(pctx=&ie->starved; *pctx; pctx=&(*pctx)->starved_next) {
+			if(*pctx==ctx) {
+				*pctx = ctx->starved_next;
+				break;
+			}
+		}
+	}
+	io_event_uring_ctx_free_locked(ie, ctx);
+	lock_unlock(ie->sq_lock);
+
+	return 0;
+}
+
+static int io_event_uring_accept(struct io_event *ie, struct io_handle *hd, SOCKET *c, struct sockaddr_in *addr)
+{
+	int i, ret = -2;
+	struct uring_ctx *ctx;
+	struct uring_accept *acc;
+
+	if(NULL==c || NULL==addr) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	lock_lock(ie->sq_lock);
+	ctx = (struct uring_ctx*)hd->backend;
+	if(NULL==ctx || 0==(ctx->op&IO_OP_ACCEPT)) {
+		lock_unlock(ie->sq_lock);
+		return socket_accept_nonblock(hd->s, c, addr);
+	}
+	for(i=0; i<URING_ACCEPT_SLOTS; ++i) {
+		acc = &ctx->accepts[i];
+		if(EUA_DONE!=acc->state) {
+			continue;
+		}
+		acc->state = EUA_FREE;
+		if(acc->res>=0) {
+			*c = acc->res;
+			memcpy(addr, &acc->addr, sizeof(struct sockaddr_in));
+			ret = 0;
+		} else if(-ECONNABORTED==acc->res) {
+			//the client is gone, go on accepting
+			ret = -3;
+		} else {
+			//such as EMFILE, not accepted again until the caller retries
+			acc->state = EUA_FAILED;
+			errno = -acc->res;
+			ret = -1;
+		}
+		break;
+	}
+	if(-2==ret) {
+		for(i=0; i<URING_ACCEPT_SLOTS; ++i) {
+			if(EUA_FAILED==ctx->accepts[i].state) {
+				ctx->accepts[i].state = EUA_FREE;
+			}
+		}
+	}
+	io_event_uring_sync_locked(ie, ctx);
+	io_event_uring_flush_locked(ie);
+	lock_unlock(ie->sq_lock);
+
+	return ret;
+}
+
+static int io_event_uring_recv(struct io_event *ie, struct io_handle *hd, char *buf, int len)
+{
+	int ret, n, copied = 0;
+	struct uring_ctx *ctx;
+#ifdef NET_HAVE_URING_BUF
+	unsigned short bid;
+#endif //NET_HAVE_URING_BUF
+
+	if(NULL==buf || len<=0) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	lock_lock(ie->sq_lock);
+	ctx = (struct uring_ctx*)hd->backend;
+	if(NULL==ctx || 0==(ctx->op&IO_OP_RECV)) {
+		lock_unlock(ie->sq_lock);
+		return socket_recv_tcp(hd->s, buf, len);
+	}
+	if(ctx->spill) {
+		//moved out while paused, it is older than the buffers
+		n = (int)(ctx->spill_len - ctx->spill_off);
+		n = (n<len) ? (n) : (len);
+		memcpy(buf, ctx->spill+ctx->spill_off, n);
+		copied += n;
+		ctx->spill_off += n;
+		if(ctx->spill_off==ctx->spill_len) {
+			mem_pool_free(ctx->spill);
+			ctx->spill = NULL;
+			ctx->spill_len = 0;
+			ctx->spill_off = 0;
+		}
+	}
+#ifdef NET_HAVE_URING_BUF
+	while(copied<len && URING_BUF_NONE != (bid = ctx->buf_head)) {
+		n = (int)(ie->buf_len[bid] - ctx->buf_off);
+		n = (n<len-copied) ? (n) : (len-copied);
+		memcpy(buf+copied, uring_buf_addr(ie->uring, bid)+ctx->buf_off, n);
+		copied += n;
+		ctx->buf_off += n;
+		if(ctx->buf_off==ie->buf_len[bid]) {
+			ctx->buf_head = ie->buf_next[bid];
+			if(URING_BUF_NONE==ctx->buf_head) {
+				ctx->buf_tail = URING_BUF_NONE;
+			}
+			ctx->buf_off = 0;
+			io_event_uring_buf_put_locked(ie, bid);
+		}
+	}
+#endif //NET_HAVE_URING_BUF
+
+	if(copied>0) {
+		if(copied<len && (ctx->eof || ctx->err)) {
+			//the caller stops at the short read, notify the end again
+			io_event_uring_kick_locked(ie, ctx);
+		}
+		ret = copied;
+	} else if(ctx->eof) {
+		ret = 0;
+	} else if(ctx->err) {
+		errno = ctx->err;
+		ret = -1;
+	} else {
+		errno = EAGAIN;
+		ret = -1;
+	}
+	io_event_uring_flush_locked(ie);
+	lock_unlock(ie->sq_lock);
+
+	return ret;
+}
+
+//free the states left, the operations are cancelled by destroying io_uring
+static void io_event_uring_release(struct io_event *ie)
+{
+	int i;
+	struct uring_ctx *ctx;
+
+	while(NULL != (ctx = ie->ctxs)) {
+		ie->ctxs = ctx->next;
+		if(ctx->op&IO_OP_ACCEPT) {
+			for(i=0; i<URING_ACCEPT_SLOTS; ++i) {
+				if(EUA_DONE==ctx->accepts[i].state && ctx->accepts[i].res>=0) {
+					close(ctx->accepts[i].res);
+				}
+			}
+		}
+		if(ctx->spill) {
+			mem_pool_free(ctx->spill);
+		}
+		if(ctx->hd) {
+			ctx->hd->backend = NULL;
+		}
+		mem_pool_free(ctx);
+	}
+}
+
+static int io_event_uring_loop(struct io_event *ie, pfunc_io_event_notify pf)
+{
+	#define MAX_CQES (64)
+	int ret, timeout, nfds, i;
+	unsigned int to_submit, flags, events;
+	unsigned long long ud;
+	struct uring_ctx *ctxs[MAX_CQES];
+	struct epoll_event evs[MAX_CQES];
+	struct io_uring_cqe *cqe;
+	struct uring_ctx *ctx;
+
+	t_loop_ie = ie;
+	ie->fired = evs;
+
+	//loop for monitoring
+	while(1) {
+		if(ie->stop) {
+			break;
+		}
+
+		timeout = (ie->hook) ? ie->hook(ie, ie->hook_arg) : -1;
+		if(ie->stop) {
+			break;
+		}
+
+		//the operations of last round and the wait share one io_uring_enter
+		lock_lock(ie->sq_lock);
+		to_submit = uring_flush_sq(ie->uring);
+		lock_unlock(ie->sq_lock);
+		//block until io event, io_event_wakeup or the time hook asked for
+		ret = uring_enter(ie->uring, to_submit, 1, /*timeout-milliseconds*/timeout);
+		if(-1==ret) {
+			if(EINTR==errno) {
+				//interrupted by highest process such as gdb
+				continue;
+			}
+			//error
+			LOG_WARN("[io_event_api] io_uring_enter failed, errno=%d", errno);
+			ie->stop = 1;
+			break;
+		}
+
+		//reap completions from the shared ring without syscall, the events of
+		//one handle are merged, the left completions make next wait return at once
+		nfds = 0;
+		lock_lock(ie->sq_lock);
+		while(nfds<MAX_CQES && NULL != (cqe = uring_peek_cqe(ie->uring))) {
+			ud = cqe->user_data;
+			ret = cqe->res;
+			flags = cqe->flags;
+			uring_cq_advance(ie->uring, 1);
+			if(ud==(unsigned long long)(unsigned long)ie) {
+				if(ret<0) {
+					LOG_WARN("[io_event_api] uring poll of wakeup failed, res=%d.", ret);
+				} else {
+					io_event_wake_drain(ie);
+				}
+				//the loop waits infinitely, it must be armed again
+				if(0==(flags&IORING_CQE_F_MORE)) {
+					io_event_uring_poll_locked(ie, ie->wake_fd, POLLIN, ud, 1);
+				}
+				continue;
+			}
+			if(0==ud) {
+				//result of cancelling or updating
+				continue;
+			}
+			ctx = URING_UD_CTX(ud);
+			events = io_event_uring_complete_locked(ie, ctx, URING_UD_OP(ud), URING_UD_IDX(ud), ret, flags);
+			if(0==events) {
+				continue;
+			}
+			if(ctx->fired) {
+				evs[ctx->fired-1].events |= events;
+				continue;
+			}
+			evs[nfds].events = events;
+			evs[nfds].data.ptr = ctx->hd;
+			ctxs[nfds] = ctx;
+			ctx->fired = ++nfds;
+		}
+		lock_unlock(ie->sq_lock);
+
+		ie->fired_count = nfds;
+		for(i=0; i<nfds; ++i) {
+			ie->fired_cur = i;
+			if(NULL!=evs[i].data.ptr) {
+				pf(ie, (struct io_handle*)evs[i].data.ptr, evs[i].events);
+			}
+			//arm the finished operations with the latest events if not deleted by pf
+			lock_lock(ie->sq_lock);
+			ctx = ctxs[i];
+			ctx->fired = 0;
+			if(ctx->hd) {
+				io_event_uring_sync_locked(ie, ctx);
+			} else {
+				io_event_uring_ctx_free_locked(ie, ctx);
+			}
+			lock_unlock(ie->sq_lock);
+		}
+		ie->fired_count = 0;
+	}
+
+	ie->fired = NULL;
+	t_loop_ie = NULL;
+	LOG_WARN("[io_event_api] event loop exit.");
+
+	return 0;
+}
+#endif //NET_HAVE_URING
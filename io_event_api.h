@@ -1,86 +1,219 @@
-/**********************************************************
-* file: io_event_api.h
-* brief: IO event model, such as select/epoll/iocp
-* 
-* author: qk
-* email: 
-* date: 2018-08
-* modify date: 
-**********************************************************/
-
-#ifndef _IO_EVENT_API_H_
-#define _IO_EVENT_API_H_
-
-#include "socket_api.h"
-#include "net_error.h"
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-struct io_handle {
-	SOCKET s;
-	char param[0];
-};
-struct io_event;
-//io event notify callback
-typedef void (*pfunc_io_event_notify)(struct io_event *ie, const struct io_handle *handle);
-
-
-/**********************************************************
- * brief: create io_event object
- * input: size, the max number of monitored object
- *
- * return: NULL error, other ok
- *********************************************************/
-struct io_event* io_event_create(int size);
-
-/**********************************************************
- * brief: loop for monitoring io event, can be run in multi-threads
- * input: ie, io event object
- *        pf, function pointer for notify outsid the io event
- *
- * return: 0 ok, -1 error
- *********************************************************/
-int io_event_loop(struct io_event *ie, pfunc_io_event_notify pf);
-
-/**********************************************************
- * brief: stop loop that monitoring io event
- * input: ie, io event object
- *
- * return: None
- *********************************************************/
-void io_event_stop_loop(struct io_event *ie);
-
-/**********************************************************
- * brief: add monitor object
- * input: ie, io event object
- *        hd, io handle
- *
- * return: 0 ok, -1 error
- *********************************************************/
-int io_event_add(struct io_event *ie, struct io_handle *hd);
-
-/**********************************************************
- * brief: delete monitor object
- * input: ie, io event object
- *        hd, io handle
- *
- * return: 0 ok, -1 error
- *********************************************************/
-int io_event_del(struct io_event *ie, struct io_handle *hd);
-
-/**********************************************************
- * brief: destroy io_event object
- * input: ie, io event object
- *
- * return: None
- *********************************************************/
-void io_event_destroy(struct io_event *ie);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif//_IO_EVENT_API_H_
-
+/**********************************************************
+* file: io_event_api.h
+* brief: IO event model, such as select/epoll/iocp
+* 
+* author: qk
+* email: 
+* date: 2018-08
+* modify date: 
+**********************************************************/
+
+#ifndef _IO_EVENT_API_H_
+#define _IO_EVENT_API_H_
+
+#include "socket_api.h"
+#include "net_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//io events
+#define IO_EVENT_READ  (0x01) //readable, also error or hang up
+#define IO_EVENT_WRITE (0x02) //writable
+#define IO_EVENT_ERROR (0x04) //error or error queue, happened with IO_EVENT_READ
+
+//operations done by io_uring backend instead of readiness, the result is
+//got by io_event_accept/io_event_recv after IO_EVENT_READ
+#define IO_OP_ACCEPT (0x01) //accept of listening socket
+#define IO_OP_RECV   (0x02) //recv of tcp socket
+
+struct io_handle {
+	SOCKET s;
+	unsigned int events; //monitored io events, only modified by io_event_api
+	void *backend;       //state of io_uring backend, only used by io_event_api
+	char param[0];
+};
+struct io_event;
+//trigger mode of monitored object
+enum EIO_TRIGGER_MODE {
+	EITM_ONESHOT=0, //edge trigger and re-arm after every event, for loop run in multi-threads
+	EITM_EDGE,      //edge trigger, loop run in one thread, must read until EAGAIN
+	EITM_LEVEL      //level trigger, loop run in one thread
+};
+//io event notify callback
+//events, IO_EVENT_READ/IO_EVENT_WRITE happened
+typedef void (*pfunc_io_event_notify)(struct io_event *ie, const struct io_handle *handle, unsigned int events);
+//io event loop hook, called before every waiting
+//return: the max milliseconds of the next waiting, -1 infinite
+typedef int (*pfunc_io_event_hook)(struct io_event *ie, void *arg);
+
+
+/**********************************************************
+ * brief: create io_event object
+ * input: size, the max number of monitored object
+ *
+ * return: NULL error, other ok
+ *********************************************************/
+struct io_event* io_event_create(int size);
+
+/**********************************************************
+ * brief: create io_event object with io_uring backend, the
+ *        objects added with IO_OP_ACCEPT/IO_OP_RECV are accepted
+ *        and received by io_uring, into the provided buffers
+ *        shared by objects, the others are polled by io_uring,
+ *        the operations and waiting are batched into one
+ *        io_uring_enter, the loop must be run in one thread
+ * input: size, the max number of monitored object
+ *
+ * return: NULL error or io_uring not supported, other ok
+ *********************************************************/
+struct io_event* io_event_create_uring(int size);
+
+/**********************************************************
+ * brief: set trigger mode of io_event object, default EITM_ONESHOT,
+ *        only affects the objects added after it
+ * input: ie, io event object
+ *        mode, trigger mode, EITM_EDGE/EITM_LEVEL drop the re-arm
+ *              syscall after every event, but only can be used
+ *              when ie loop is run in one thread
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int io_event_set_trigger(struct io_event *ie, enum EIO_TRIGGER_MODE mode);
+
+/**********************************************************
+ * brief: set loop hook of io_event object, it is called in loop
+ *        thread before every waiting, such as for timers
+ * input: ie, io event object
+ *        pf, hook function, NULL clear the hook
+ *        arg, param for pf
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int io_event_set_hook(struct io_event *ie, pfunc_io_event_hook pf, void *arg);
+
+/**********************************************************
+ * brief: loop for monitoring io event, can be run in multi-threads
+ *        if trigger mode is EITM_ONESHOT
+ * input: ie, io event object
+ *        pf, function pointer for notify outsid the io event
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int io_event_loop(struct io_event *ie, pfunc_io_event_notify pf);
+
+/**********************************************************
+ * brief: stop loop that monitoring io event
+ * input: ie, io event object
+ *
+ * return: None
+ *********************************************************/
+void io_event_stop_loop(struct io_event *ie);
+
+/**********************************************************
+ * brief: wake up the loop that is waiting for io event, can be
+ *        called in any thread, the loop waits infinitely otherwise
+ * input: ie, io event object
+ *
+ * return: None
+ *********************************************************/
+void io_event_wakeup(struct io_event *ie);
+
+/**********************************************************
+ * brief: add monitor object, monitor IO_EVENT_READ
+ * input: ie, io event object
+ *        hd, io handle
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int io_event_add(struct io_event *ie, struct io_handle *hd);
+
+/**********************************************************
+ * brief: add monitor object with operations done by io_uring
+ *        backend, the other backends ignore op
+ * input: ie, io event object
+ *        hd, io handle
+ *        op, IO_OP_ACCEPT/IO_OP_RECV, 0 readiness only
+ *        events, IO_EVENT_READ/IO_EVENT_WRITE monitored, 0 until
+ *                io_event_mod
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int io_event_add_ex(struct io_event *ie, struct io_handle *hd, unsigned int op, unsigned int events);
+
+/**********************************************************
+ * brief: accept client of object added with IO_OP_ACCEPT after
+ *        IO_EVENT_READ, it is accepted by io_uring, or by
+ *        socket_accept_nonblock for the other backends
+ * input: ie, io event object
+ *        hd, io handle of listening socket
+ *        c, accepted socket, non-blocking
+ *        addr, address of client
+ *
+ * return: same as socket_accept_nonblock, -2 nothing accepted,
+ *         -1 error and the failed accepting is tried again by
+ *         the next call returning -2
+ *********************************************************/
+int io_event_accept(struct io_event *ie, struct io_handle *hd, SOCKET *c, struct sockaddr_in *addr);
+
+/**********************************************************
+ * brief: receive data of object added with IO_OP_RECV after
+ *        IO_EVENT_READ, the data received by io_uring is copied,
+ *        or received by socket_recv_tcp for the other backends
+ * input: ie, io event object
+ *        hd, io handle
+ *        buf, buffer for data
+ *        len, buffer len
+ *
+ * return: same as socket_recv_tcp, less than len only if nothing
+ *         is left, -1 with errno EAGAIN if nothing received
+ *********************************************************/
+int io_event_recv(struct io_event *ie, struct io_handle *hd, char *buf, int len);
+
+/**********************************************************
+ * brief: modify the monitored io events of object, can be
+ *        called in any thread
+ * input: ie, io event object
+ *        hd, io handle that has been added
+ *        events, IO_EVENT_READ/IO_EVENT_WRITE, 0 stop monitoring
+ *                until next modifying
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int io_event_mod(struct io_event *ie, struct io_handle *hd, unsigned int events);
+
+/**********************************************************
+ * brief: delete monitor object
+ * input: ie, io event object
+ *        hd, io handle
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int io_event_del(struct io_event *ie, struct io_handle *hd);
+
+/**********************************************************
+ * brief: drop the io events of deleted object that are not
+ *        handled yet, called in loop thread before the object
+ *        deleted by other threads is freed
+ * input: ie, io event object
+ *        hd, io handle that has been deleted
+ *
+ * return: None
+ *********************************************************/
+void io_event_forget(struct io_event *ie, struct io_handle *hd);
+
+/**********************************************************
+ * brief: destroy io_event object
+ * input: ie, io event object
+ *
+ * return: None
+ *********************************************************/
+void io_event_destroy(struct io_event *ie);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//_IO_EVENT_API_H_
+
@@ -1,38 +1,38 @@
-/**********************************************************
-* file: net.h
-* brief: net communication lib
-* 
-* author: qk
-* email: 
-* date: 2018-08
-* modify date: 
-**********************************************************/
-
-#ifndef _NET_H_
-#define _NET_H_
-
-#ifdef __cplusplus
-extern "C" {
-#endif 
-
-extern __thread int net_errno;
-
-#include "typedef.h"
-#include "atomic.h"
-#include "log.h"
-#include "hash_map.h"
-#include "mem_pool.h"
-#include "sleep.h"
-#include "thread.h"
-#include "thread_lock.h"
-#include "thread_wait.h"
-#include "socket_api.h"
-#include "io_event.h"
-#include "net_error.h"
-
-#ifdef __cplusplus
-}
-#endif 
-
-#endif //_NET_H_
-
+/**********************************************************
+* file: net.h
+* brief: net communication lib
+* 
+* author: qk
+* email: 
+* date: 2018-08
+* modify date: 
+**********************************************************/
+
+#ifndef _NET_H_
+#define _NET_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif 
+
+extern __thread int net_errno;
+
+#include "typedef.h"
+#include "atomic.h"
+#include "log.h"
+#include "hash_map.h"
+#include "mem_pool.h"
+#include "sleep.h"
+#include "thread.h"
+#include "thread_lock.h"
+#include "thread_wait.h"
+#include "socket_api.h"
+#include "io_event.h"
+#include "net_error.h"
+
+#ifdef __cplusplus
+}
+#endif 
+
+#endif //_NET_H_
+
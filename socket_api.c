@@ -1,468 +1,1044 @@
-#include "socket_api.h"
-#include <string.h>
-#include "log.h"
-#include "net_error.h"
-
-#ifdef _WIN32
-  #include <Ws2tcpip.h>
-  #include <Iphlpapi.h>    /*Iphlpapi.lib*/
-#else
-  /*fcntl*/
-  #include <unistd.h>
-  #include <fcntl.h>
-  /*ioctl*/
-  #include <sys/ioctl.h>
-  /*getaddrinfo*/
-  #include <netdb.h>
-  /*struct ifreq*/
-  #include <net/if.h>
-  #include <errno.h>
-  #include <sys/select.h>
-#endif //_WIN32
-
-//listening queue length
-#define NET_LISTEN_QUEUE_LEN (10)
-
-static SOCKET socket_create_server(unsigned short port, int flag);
-static SOCKET socket_connect_server(const char *ip, unsigned short port, int flag);
-
-//return: -2 timeout, -1 error, 0-ok
-static int socket_check_connect(SOCKET s);
-
-int socket_init_env()
-{
-#ifdef _WIN32
-	WORD wVersionRequested;
-	WSADATA wsaData;
-	int err;
-	/* Use the MAKEWORD(lowbyte, highbyte) macro declared in Windef.h */
-	wVersionRequested = MAKEWORD(2, 2);
-	err = WSAStartup(wVersionRequested, &wsaData);
-	if (err != 0) {
-		/* Tell the user that we could not find a usable */
-		/* Winsock DLL.                                  */
-		LOG_WARN("[socket_api] socket init failed, WSAStartup failed with error: %d", err);
-		return -1;
-	}
-	/* Confirm that the WinSock DLL supports 2.2./
-	/ Note that if the DLL supports versions greater    /
-	/ than 2.2 in addition to 2.2, it will still return /
-	/ 2.2 in wVersion since that is the version we      /
-	/ requested.                                       */
-	if (LOBYTE(wsaData.wVersion) != 2 || HIBYTE(wsaData.wVersion) != 2) {
-		/* Tell the user that we could not find a usable */
-		/* WinSock DLL.                                  */
-		LOG_WARN("[socket_api] Could not find a usable version of Winsock.dll");
-		WSACleanup();
-		return 1;
-	}
-#endif //_WIN32
-
-	return 0;
-}
-
-void socket_release_env()
-{
-#ifdef _WIN32
-	WSACleanup();
-#endif //_WIN32
-}
-
-SOCKET socket_create_tcp(const char *ip, unsigned short port)
-{
-	SOCKET s;
-	if(NULL==ip || '\0'==*ip) {
-		s = socket_create_server(port, SOCK_STREAM);
-		//windows: 0 ok, SOCKET_ERROR (-1) error
-		//linux: 0 ok, -1 error
-		if(0==listen(s, NET_LISTEN_QUEUE_LEN)) {
-			return s;
-		} else {
-			socket_close(s);
-			LOG_WARN("[socket_api] socket create tcp failed, listen at s=%d error.", s);
-			return -1;
-		}
-	}
-	else {
-		return socket_connect_server(ip, port, SOCK_STREAM);
-	}
-}
-
-SOCKET socket_create_udp(const char *ip, unsigned short port)
-{
-	if(NULL==ip || '\0'==*ip) {
-		return socket_create_server(port, SOCK_DGRAM);
-	}
-	else {
-		return socket_connect_server(ip, port, SOCK_DGRAM);
-	}
-}
-
-static SOCKET socket_create_server(unsigned short port, int flag)
-{
-	SOCKET s;
-	struct sockaddr_in addr;
-
-	/*struct sockaddr {
-		sa_family_t sin_family;    //address family
-		char        sa_data[14];   //14byte, include dest addr and port
-	};
-	struct sockaddr_in {
-		sa_family_t    sin_family;  //address family
-		uint16_t       sin_port;    //16bit TCP/UDP port
-		struct in_addr sin_addr;    //32bit IP addr
-		char           sin_zero[8]; //reserve
-	};
-	typedef uint32_t in_addr_t;
-	struct in_addr {
-		in_addr_t s_addr;
-	};
-	*/
-
-	//If a value of 0 is specified, the caller does not wish to specify a protocol 
-	//and the service provider will choose the protocol to use.
-	s = socket(AF_INET, flag, 0);
-	if(INVALID_SOCKET==s) {
-		net_errno = NET_ERROR_MALLOC_SOCKET;
-		return -1;
-	}
-
-	//set nonblock
-	if(-1==socket_set_nonblock(s)) {
-		socket_close(s);
-		net_errno = NET_ERROR_SET_NONBLOCK;
-		return -1;
-	}
-
-	memset(&addr, 0, sizeof(addr));
-	addr.sin_family = AF_INET;
-	addr.sin_port = htons(port);
-	addr.sin_addr.s_addr = htonl(INADDR_ANY);
-	//bind
-	if(0 != bind(s, (struct sockaddr*)&addr, sizeof(struct sockaddr))) {
-		socket_close(s);
-		LOG_WARN("[socket_api] socket create server failed, bind socket s=%d error, errno=%d", s, errno);
-		net_errno = NET_ERROR_BIND;
-		return -1;
-	}
-
-	return s;
-}
-
-static SOCKET socket_connect_server(const char *ip, unsigned short port, int flag)
-{
-	int ret;
-	unsigned int ipval;
-	SOCKET s;
-	struct sockaddr_in addr;
-
-	if(NULL==ip || '\0'==*ip || 0==port) {
-		net_errno = NET_ERROR_INVALID_PARAM;
-		return -1;
-	}
-
-	ipval = socket_convert_ip2val(ip);
-
-	s = socket(AF_INET, flag, 0);
-	if(INVALID_SOCKET==s) {
-		net_errno = NET_ERROR_MALLOC_SOCKET;
-		return -1;
-	}
-
-	//set nonblock
-	if(-1==socket_set_nonblock(s)) {
-		socket_close(s);
-		net_errno = NET_ERROR_SET_NONBLOCK;
-		return -1;
-	}
-
-	memset(&addr, 0, sizeof(addr));
-	addr.sin_family = AF_INET;
-	addr.sin_port = htons(port);
-	addr.sin_addr.s_addr = ipval;
-
-	//connect
-	if(0 != connect(s, (struct sockaddr*)&addr, sizeof(struct sockaddr))) {
-		ret = errno;
-		if(EINPROGRESS/*115*/==errno) {
-			//The socket is non-blocking and the connection cannot be completed immediately.
-			if(0==(ret=socket_check_connect(s))) {
-				return s;
-			}
-		}
-		socket_close(s);
-		if(-2==ret) {
-			LOG_WARN("[socket_api] socket connect server timeout.");
-		} else {
-			LOG_WARN("[socket_api] socket connect server failed, errno=%d.", errno);
-		}
-		net_errno = NET_ERROR_CONNECT;
-		return -1;
-	}
-
-	return s;
-}
-
-static int socket_check_connect(SOCKET s)
-{
-	int ret;
-	fd_set rfds, wfds;
-	struct timeval tv;
-	int error;
-	socklen_t len;
-
-	FD_ZERO(&rfds);
-	FD_ZERO(&wfds);
-	FD_SET(s, &rfds);
-	FD_SET(s, &wfds);
-
-	tv.tv_sec = 5;
-	tv.tv_usec = 0;
-	ret = select(s+1, &rfds, &wfds, NULL, &tv);
-	switch(ret) {
-		case -1: //error
-			break;
-		case 0: //time out
-			ret = -2;
-			break;
-		default: //have event
-			if(FD_ISSET(s, &rfds) || FD_ISSET(s, &wfds)) {
-				len = sizeof(error);
-				ret = getsockopt(s, SOL_SOCKET, SO_ERROR, &error, &len);
-				if(ret<0 || error) {
-					//error
-					ret = -1;
-				} else {
-					ret = 0;
-				}
-			}
-			break;
-	}
-
-	return ret;
-}
-
-int socket_accept_client(SOCKET s, SOCKET *c, struct sockaddr *addr)
-{
-	socklen_t len;
-
-	if(NULL==c || NULL==addr) {
-		return -1;
-	}
-
-	len = sizeof(struct sockaddr);
-	*c = accept(s, addr, &len);
-	
-	return (INVALID_SOCKET==*c) ? -1 : 0;
-}
-
-int socket_send_tcp(SOCKET s, const char *data, int len)
-{
-	int ret;
-	int count=3;
-	if(NULL==data || 0==len) {
-		net_errno = NET_ERROR_INVALID_PARAM;
-		return -1;
-	}
-
-#ifdef _WIN32
-	ret = send(s, data, len, 0);
-#else
-	do {
-		//MSG_NOSIGNAL (since Linux 2.2)
-		ret = send(s, data, len, MSG_NOSIGNAL);
-		if(ret < 0) {
-			if(EAGAIN==errno || EWOULDBLOCK==errno) {
-				//go on
-			} else if(EPIPE==errno) {
-				//The local end has been shut down on a connection oriented socket
-				return -1;
-			}
-		}
-		
-		if(ret>=len) {
-			break;
-		}
-	}while(--count);
-#endif //_WIN32
-
-	return ret;
-}
-
-int socket_recv_tcp(SOCKET s, char *buf, int len)
-{
-	if(NULL==buf || 0==len) {
-		net_errno = NET_ERROR_INVALID_PARAM;
-		return -1;
-	}
-
-	return recv(s, buf, len, 0);
-}
-
-int socket_send_udp(SOCKET s, /*struct sockaddr *peer_addr,*/const char *data, int len)
-{
-	//struct sockaddr detail, see function socket_create_server
-	if(/*NULL==peer_addr ||*/ NULL==data || 0==len) {
-		net_errno = NET_ERROR_INVALID_PARAM;
-		return -1;
-	}
-
-#ifndef _WIN32
-	return sendto(s, data, len, 0, /*peer_addr*/NULL, /*sizeof(struct sockaddr)*/0);
-#else
-	return sendto(s, data, len, MSG_NOSIGNAL, /*peer_addr*/NULL, /*sizeof(struct sockaddr)*/0);
-#endif //_WIN32
-}
-
-int socket_recv_udp(SOCKET s, /*struct sockaddr *peer_addr,*/ char *buf, int len)
-{
-	int addr_len;
-
-	if(/*NULL==peer_addr ||*/ NULL==buf || 0==len) {
-		net_errno = NET_ERROR_INVALID_PARAM;
-		return -1;
-	}
-
-	addr_len = sizeof(struct sockaddr);
-
-	return recvfrom(s, buf, len, 0, /*peer_addr*/NULL, /*&addr_len*/0);
-}
-
-void socket_close(SOCKET s)
-{
-#ifdef _WIN32
-	closesocket(s);
-#else
-	close(s);
-#endif //_WIN32
-}
-
-int socket_set_nonblock(SOCKET s)
-{
-	int flag;
-#ifdef _WIN32
-	/*Set the socket I/O mode: In this case FIONBIO
-	enables or disables the blocking mode for the
-	socket based on the numerical value of iMode.
-	If iMode = 0, blocking is enabled;
-	If iMode != 0, non-blocking mode is enabled.
-	*/
-	flag = 1;
-	return (NO_ERROR == ioctlsocket(s, FIONBIO, &flag)) ? 0 : -1;
-#else
-	flag = fcntl(s, F_GETFL);
-	flag |= O_NONBLOCK;
-
-	return (0==fcntl(s, F_SETFL, flag)) ? 0 : -1;
-#endif //_WIN32
-}
-
-int socket_get_local_addr(SOCKET s, struct sockaddr_in *addr)
-{
-	socklen_t addr_len = sizeof(struct sockaddr);
-	//On success, zero is returned.  On error, -1 is returned
-	return (addr) ? getsockname(s, (struct sockaddr*)addr, &addr_len) : -1;
-}
-
-int socket_get_peer_addr(SOCKET s, struct sockaddr_in *addr)
-{
-	socklen_t addr_len = sizeof(struct sockaddr);
-	//On success, zero is returned.  On error, -1 is returned
-	return (addr) ? getpeername(s, (struct sockaddr*)addr, &addr_len) : -1;
-}
-
-char* socket_get_host_ip(const char *host)
-{
-	int ret;
-	struct addrinfo hints;
-	struct addrinfo *res, *next;
-	unsigned int ipvalue = 0;
-
-	if(NULL==host || '\0'==*host) {
-		return NULL;
-	}
-
-	memset(&hints, 0, sizeof(struct addrinfo));
-	hints.ai_family = AF_INET;
-	hints.ai_socktype = SOCK_STREAM;
-	hints.ai_protocol = IPPROTO_TCP; //0 any protocol
-	hints.ai_flags = AI_PASSIVE; //for tcp
-	
-	if(0==(ret=getaddrinfo(host, NULL, &hints, &res))) {
-		next = res;
-		while(res) {
-			next = res->ai_next;
-			//struct sockaddr
-			ipvalue = ((struct sockaddr_in*)res->ai_addr)->sin_addr.s_addr;
-			freeaddrinfo(res);
-			res = next;
-		};
-
-		return socket_convert_val2ip(ipvalue);
-	} else {
-		LOG_WARN("[socket_api] getaddrinfo(host=%s) failed errno=%d,%s", host, ret, gai_strerror(ret));
-	}
-
-	return NULL;
-}
-
-unsigned int socket_get_netcard_ip(const char *eth)
-{
-	SOCKET s;
-	unsigned int ip=0;
-	struct ifreq ifr;
-
-	if(NULL==eth || '\0'==*eth) {
-		return 0;
-	}
-
-	if( (s = socket(AF_INET, SOCK_STREAM, 0)) != -1) {
-		memset(&ifr, 0, sizeof(struct ifreq));
-		strncpy(ifr.ifr_name, eth, sizeof(ifr.ifr_name)-1);
-		
-		if(0==ioctl(s, SIOCGIFADDR, &ifr)) {
-			//struct sockaddr, ifr.ifr_addr
-			//equal struct sockaddr_in
-			ip = ((struct sockaddr_in*)&ifr.ifr_addr)->sin_addr.s_addr;
-		}
-		socket_close(s);
-	} else {
-		LOG_WARN("[socket_api] socket failed errno=%d", errno);
-	}
-
-	return ip;
-}
-
-unsigned int socket_convert_ip2val(const char *ip)
-{
-	struct in_addr ia;
-
-	if(NULL==ip || '\0'==*ip) {
-		return -1;
-	}
-
-	if(0==inet_aton(ip, &ia)) {
-		//returns non-zero if the address is valid, zero if not
-		LOG_WARN("[socket_api] inet_aton(%s) failed", ip);
-		return -1;
-	}
-
-	return ia.s_addr;
-	//return inet_addr(ip).s_addr;
-}
-
-char* socket_convert_val2ip(unsigned int ipval)
-{
-	/*typedef uint32_t in_addr_t;
-	struct in_addr {
-		in_addr_t s_addr;
-	};
-	*/
-	struct in_addr ia;
-	ia.s_addr = ipval;
-
-	//The string is returned in a statically allocated buffer, 
-	// which subsequent calls will overwrite.
-	return inet_ntoa(ia);
-}
-
+#ifndef _WIN32
+  #ifndef _GNU_SOURCE
+    /*recvmmsg*/
+    #define _GNU_SOURCE
+  #endif
+#endif //_WIN32
+#include "socket_api.h"
+#include <string.h>
+#include "log.h"
+#include "net_error.h"
+
+#ifdef _WIN32
+  #include <Ws2tcpip.h>
+  #include <Iphlpapi.h>    /*Iphlpapi.lib*/
+#else
+  /*fcntl*/
+  #include <unistd.h>
+  #include <fcntl.h>
+  /*ioctl*/
+  #include <sys/ioctl.h>
+  /*getaddrinfo*/
+  #include <netdb.h>
+  /*struct ifreq*/
+  #include <net/if.h>
+  #include <errno.h>
+  #include <sys/select.h>
+  /*UDP_SEGMENT*/
+  #include <netinet/udp.h>
+  /*TCP_FASTOPEN_CONNECT*/
+  #include <netinet/tcp.h>
+#endif //_WIN32
+
+#if !defined(_WIN32) && defined(__has_include)
+  #if __has_include(<linux/errqueue.h>)
+    /*struct sock_extended_err*/
+    #include <linux/errqueue.h>
+    #if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+      #define NET_HAVE_ZEROCOPY
+    #endif
+  #endif
+#endif
+
+//default listening queue length
+#define NET_LISTEN_QUEUE_LEN (SOMAXCONN)
+//max datagrams sent by one sendmmsg
+#define NET_UDP_SEND_MAX (256)
+//max segments and payload of one udp gso send
+#define NET_UDP_GSO_SEGS (64)
+#define NET_UDP_GSO_LEN  (65507)
+
+static SOCKET socket_create_server(unsigned short port, int flag);
+static SOCKET socket_connect_server(const char *ip, unsigned short port, int flag);
+
+//return: -2 timeout, -1 error, 0-ok
+static int socket_check_connect(SOCKET s);
+
+int socket_init_env()
+{
+#ifdef _WIN32
+	WORD wVersionRequested;
+	WSADATA wsaData;
+	int err;
+	/* Use the MAKEWORD(lowbyte, highbyte) macro declared in Windef.h */
+	wVersionRequested = MAKEWORD(2, 2);
+	err = WSAStartup(wVersionRequested, &wsaData);
+	if (err != 0) {
+		/* Tell the user that we could not find a usable */
+		/* Winsock DLL.                                  */
+		LOG_WARN("[socket_api] socket init failed, WSAStartup failed with error: %d", err);
+		return -1;
+	}
+	/* Confirm that the WinSock DLL supports 2.2./
+	/ Note that if the DLL supports versions greater    /
+	/ than 2.2 in addition to 2.2, it will still return /
+	/ 2.2 in wVersion since that is the version we      /
+	/ requested.                                       */
+	if (LOBYTE(wsaData.wVersion) != 2 || HIBYTE(wsaData.wVersion) != 2) {
+		/* Tell the user that we could not find a usable */
+		/* WinSock DLL.                                  */
+		LOG_WARN("[socket_api] Could not find a usable version of Winsock.dll");
+		WSACleanup();
+		return 1;
+	}
+#endif //_WIN32
+
+	return 0;
+}
+
+void socket_release_env()
+{
+#ifdef _WIN32
+	WSACleanup();
+#endif //_WIN32
+}
+
+SOCKET socket_create_tcp(const char *ip, unsigned short port)
+{
+	return socket_create_tcp_ex(ip, port, NET_LISTEN_QUEUE_LEN);
+}
+
+SOCKET socket_create_tcp_ex(const char *ip, unsigned short port, int backlog)
+{
+	SOCKET s;
+	if(NULL==ip || '\0'==*ip) {
+		s = socket_create_server(port, SOCK_STREAM);
+		//windows: 0 ok, SOCKET_ERROR (-1) error
+		//linux: 0 ok, -1 error
+		if(0==listen(s, (backlog>0) ? backlog : NET_LISTEN_QUEUE_LEN)) {
+			return s;
+		} else {
+			socket_close(s);
+			LOG_WARN("[socket_api] socket create tcp failed, listen at s=%d error.", s);
+			return -1;
+		}
+	}
+	else {
+		return socket_connect_server(ip, port, SOCK_STREAM);
+	}
+}
+
+SOCKET socket_connect_nonblock(const char *ip, unsigned short port, int fastopen, int *pending)
+{
+	SOCKET s;
+	struct sockaddr_in addr;
+
+	if(NULL==ip || '\0'==*ip || 0==port || NULL==pending) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return INVALID_SOCKET;
+	}
+
+	s = socket(AF_INET, SOCK_STREAM, 0);
+	if(INVALID_SOCKET==s) {
+		net_errno = NET_ERROR_MALLOC_SOCKET;
+		return INVALID_SOCKET;
+	}
+
+	if(-1==socket_set_nonblock(s)) {
+		socket_close(s);
+		net_errno = NET_ERROR_SET_NONBLOCK;
+		return INVALID_SOCKET;
+	}
+
+#if !defined(_WIN32) && defined(TCP_FASTOPEN_CONNECT)
+	//TCP_FASTOPEN_CONNECT (since Linux 4.11), connect returns at once and
+	//the SYN carries the first data with cookie, no RTT on reconnecting
+	if(fastopen && 0!=setsockopt(s, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &fastopen, sizeof(fastopen))) {
+		LOG_DEBUG("[socket_api] socket set fastopen connect failed, errno=%d.", errno);
+	}
+#else
+	(void)fastopen; //use variable only for compiler
+#endif
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = socket_convert_ip2val(ip);
+
+	*pending = 0;
+	if(0 != connect(s, (struct sockaddr*)&addr, sizeof(struct sockaddr))) {
+#ifdef _WIN32
+		if(WSAEWOULDBLOCK==WSAGetLastError()) {
+#else
+		if(EINPROGRESS==errno) {
+#endif //_WIN32
+			*pending = 1;
+			return s;
+		}
+		LOG_WARN("[socket_api] socket connect server failed, errno=%d.", errno);
+		socket_close(s);
+		net_errno = NET_ERROR_CONNECT;
+		return INVALID_SOCKET;
+	}
+
+	return s;
+}
+
+SOCKET socket_create_udp(const char *ip, unsigned short port)
+{
+	if(NULL==ip || '\0'==*ip) {
+		return socket_create_server(port, SOCK_DGRAM);
+	}
+	else {
+		return socket_connect_server(ip, port, SOCK_DGRAM);
+	}
+}
+
+static SOCKET socket_create_server(unsigned short port, int flag)
+{
+	SOCKET s;
+	struct sockaddr_in addr;
+
+	/*struct sockaddr {
+		sa_family_t sin_family;    //address family
+		char        sa_data[14];   //14byte, include dest addr and port
+	};
+	struct sockaddr_in {
+		sa_family_t    sin_family;  //address family
+		uint16_t       sin_port;    //16bit TCP/UDP port
+		struct in_addr sin_addr;    //32bit IP addr
+		char           sin_zero[8]; //reserve
+	};
+	typedef uint32_t in_addr_t;
+	struct in_addr {
+		in_addr_t s_addr;
+	};
+	*/
+
+	//If a value of 0 is specified, the caller does not wish to specify a protocol 
+	//and the service provider will choose the protocol to use.
+	s = socket(AF_INET, flag, 0);
+	if(INVALID_SOCKET==s) {
+		net_errno = NET_ERROR_MALLOC_SOCKET;
+		return -1;
+	}
+
+	//set nonblock
+	if(-1==socket_set_nonblock(s)) {
+		socket_close(s);
+		net_errno = NET_ERROR_SET_NONBLOCK;
+		return -1;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	//bind
+	if(0 != bind(s, (struct sockaddr*)&addr, sizeof(struct sockaddr))) {
+		socket_close(s);
+		LOG_WARN("[socket_api] socket create server failed, bind socket s=%d error, errno=%d", s, errno);
+		net_errno = NET_ERROR_BIND;
+		return -1;
+	}
+
+	return s;
+}
+
+static SOCKET socket_connect_server(const char *ip, unsigned short port, int flag)
+{
+	int ret;
+	unsigned int ipval;
+	SOCKET s;
+	struct sockaddr_in addr;
+
+	if(NULL==ip || '\0'==*ip || 0==port) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	ipval = socket_convert_ip2val(ip);
+
+	s = socket(AF_INET, flag, 0);
+	if(INVALID_SOCKET==s) {
+		net_errno = NET_ERROR_MALLOC_SOCKET;
+		return -1;
+	}
+
+	//set nonblock
+	if(-1==socket_set_nonblock(s)) {
+		socket_close(s);
+		net_errno = NET_ERROR_SET_NONBLOCK;
+		return -1;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = ipval;
+
+	//connect
+	if(0 != connect(s, (struct sockaddr*)&addr, sizeof(struct sockaddr))) {
+		ret = errno;
+		if(EINPROGRESS/*115*/==errno) {
+			//The socket is non-blocking and the connection cannot be completed immediately.
+			if(0==(ret=socket_check_connect(s))) {
+				return s;
+			}
+		}
+		socket_close(s);
+		if(-2==ret) {
+			LOG_WARN("[socket_api] socket connect server timeout.");
+		} else {
+			LOG_WARN("[socket_api] socket connect server failed, errno=%d.", errno);
+		}
+		net_errno = NET_ERROR_CONNECT;
+		return -1;
+	}
+
+	return s;
+}
+
+static int socket_check_connect(SOCKET s)
+{
+	int ret;
+	fd_set rfds, wfds;
+	struct timeval tv;
+	int error;
+	socklen_t len;
+
+	FD_ZERO(&rfds);
+	FD_ZERO(&wfds);
+	FD_SET(s, &rfds);
+	FD_SET(s, &wfds);
+
+	tv.tv_sec = 5;
+	tv.tv_usec = 0;
+	ret = select(s+1, &rfds, &wfds, NULL, &tv);
+	switch(ret) {
+		case -1: //error
+			break;
+		case 0: //time out
+			ret = -2;
+			break;
+		default: //have event
+			if(FD_ISSET(s, &rfds) || FD_ISSET(s, &wfds)) {
+				len = sizeof(error);
+				ret = getsockopt(s, SOL_SOCKET, SO_ERROR, &error, &len);
+				if(ret<0 || error) {
+					//error
+					ret = -1;
+				} else {
+					ret = 0;
+				}
+			}
+			break;
+	}
+
+	return ret;
+}
+
+int socket_accept_client(SOCKET s, SOCKET *c, struct sockaddr *addr)
+{
+	socklen_t len;
+
+	if(NULL==c || NULL==addr) {
+		return -1;
+	}
+
+	len = sizeof(struct sockaddr);
+	*c = accept(s, addr, &len);
+	
+	return (INVALID_SOCKET==*c) ? -1 : 0;
+}
+
+int socket_accept_nonblock(SOCKET s, SOCKET *c, struct sockaddr_in *addr)
+{
+	socklen_t len;
+
+	if(NULL==c || NULL==addr) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	len = sizeof(struct sockaddr_in);
+#ifdef _WIN32
+	*c = accept(s, (struct sockaddr*)addr, &len);
+	if(INVALID_SOCKET==*c) {
+		return (WSAEWOULDBLOCK==WSAGetLastError()) ? (-2) : (-1);
+	}
+	if(-1==socket_set_nonblock(*c)) {
+		socket_close(*c);
+		net_errno = NET_ERROR_SET_NONBLOCK;
+		return -1;
+	}
+#else
+	do {
+		//accept4 (since Linux 2.6.28), no fcntl for every client
+		*c = accept4(s, (struct sockaddr*)addr, &len, SOCK_NONBLOCK|SOCK_CLOEXEC);
+	}while(INVALID_SOCKET==*c && EINTR==errno);
+
+	if(INVALID_SOCKET==*c) {
+		//ECONNABORTED, the client is gone, go on accepting
+		return (EAGAIN==errno || EWOULDBLOCK==errno) ? (-2) : ((ECONNABORTED==errno) ? (-3) : (-1));
+	}
+#endif //_WIN32
+
+	return 0;
+}
+
+int socket_send_tcp(SOCKET s, const char *data, int len)
+{
+	int ret;
+	if(NULL==data || 0==len) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+#ifdef _WIN32
+	ret = send(s, data, len, 0);
+	if(SOCKET_ERROR==ret && WSAEWOULDBLOCK==WSAGetLastError()) {
+		ret = 0;
+	}
+#else
+	do {
+		//MSG_NOSIGNAL (since Linux 2.2)
+		ret = send(s, data, len, MSG_NOSIGNAL);
+	}while(ret<0 && EINTR==errno);
+
+	if(ret<0 && (EAGAIN==errno || EWOULDBLOCK==errno)) {
+		//socket send buffer is full, not retry here
+		return 0;
+	}
+	//EPIPE, the local end has been shut down on a connection oriented socket
+#endif //_WIN32
+
+	if(ret<0) {
+		net_errno = NET_ERROR_SEND;
+	}
+	return ret;
+}
+
+int socket_send_tcpv(SOCKET s, const struct iovec *iov, int cnt)
+{
+	int ret;
+#ifdef _WIN32
+	int i;
+	DWORD sent;
+	WSABUF bufs[NET_IOV_MAX];
+#else
+	struct msghdr msg;
+#endif //_WIN32
+
+	if(NULL==iov || cnt<=0) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+	if(cnt>NET_IOV_MAX) {
+		//the left is sent by next call
+		cnt = NET_IOV_MAX;
+	}
+
+#ifdef _WIN32
+	for(i=0; i<cnt; ++i) {
+		bufs[i].buf = (CHAR*)iov[i].iov_base;
+		bufs[i].len = (ULONG)iov[i].iov_len;
+	}
+	ret = WSASend(s, bufs, (DWORD)cnt, &sent, 0, NULL, NULL);
+	if(0==ret) {
+		ret = (int)sent;
+	} else if(WSAEWOULDBLOCK==WSAGetLastError()) {
+		ret = 0;
+	}
+#else
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = (struct iovec*)iov;
+	msg.msg_iovlen = cnt;
+	do {
+		//sendmsg instead of writev for MSG_NOSIGNAL
+		ret = sendmsg(s, &msg, MSG_NOSIGNAL);
+	}while(ret<0 && EINTR==errno);
+
+	if(ret<0 && (EAGAIN==errno || EWOULDBLOCK==errno)) {
+		//socket send buffer is full, not retry here
+		return 0;
+	}
+#endif //_WIN32
+
+	if(ret<0) {
+		net_errno = NET_ERROR_SEND;
+	}
+	return ret;
+}
+
+int socket_recv_tcp(SOCKET s, char *buf, int len)
+{
+	if(NULL==buf || 0==len) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	return recv(s, buf, len, 0);
+}
+
+int socket_send_udp(SOCKET s, /*struct sockaddr *peer_addr,*/const char *data, int len)
+{
+	//struct sockaddr detail, see function socket_create_server
+	if(/*NULL==peer_addr ||*/ NULL==data || 0==len) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+#ifndef _WIN32
+	return sendto(s, data, len, 0, /*peer_addr*/NULL, /*sizeof(struct sockaddr)*/0);
+#else
+	return sendto(s, data, len, MSG_NOSIGNAL, /*peer_addr*/NULL, /*sizeof(struct sockaddr)*/0);
+#endif //_WIN32
+}
+
+int socket_send_udp_to(SOCKET s, const struct sockaddr_in *peer_addr, const char *data, int len)
+{
+	if(NULL==peer_addr || NULL==data || 0==len) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	return sendto(s, data, len, 0, (const struct sockaddr*)peer_addr, sizeof(struct sockaddr_in));
+}
+
+int socket_send_udpv(SOCKET s, const struct sockaddr_in *peer_addr, const struct iovec *iov, int cnt)
+{
+	int ret;
+#ifdef _WIN32
+	int i;
+	DWORD sent;
+	WSABUF bufs[NET_IOV_MAX];
+#else
+	struct msghdr msg;
+#endif //_WIN32
+
+	if(NULL==iov || cnt<=0 || cnt>NET_IOV_MAX) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+#ifdef _WIN32
+	for(i=0; i<cnt; ++i) {
+		bufs[i].buf = (CHAR*)iov[i].iov_base;
+		bufs[i].len = (ULONG)iov[i].iov_len;
+	}
+	ret = WSASendTo(s, bufs, (DWORD)cnt, &sent, 0, (const struct sockaddr*)peer_addr,
+			(peer_addr) ? sizeof(struct sockaddr_in) : 0, NULL, NULL);
+	if(0==ret) {
+		ret = (int)sent;
+	}
+#else
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name = (void*)peer_addr;
+	msg.msg_namelen = (peer_addr) ? sizeof(struct sockaddr_in) : 0;
+	msg.msg_iov = (struct iovec*)iov;
+	msg.msg_iovlen = cnt;
+	ret = sendmsg(s, &msg, 0);
+#endif //_WIN32
+
+	return ret;
+}
+
+#if !defined(_WIN32) && defined(UDP_SEGMENT)
+//count of datagrams from msgs can be sent as one gso send
+static int socket_udp_gso_count(const struct udp_msg *msgs, int cnt)
+{
+	int i, total;
+	int size = msgs[0].len;
+
+	total = size;
+	for(i=1; i<cnt && i<NET_UDP_GSO_SEGS; ++i) {
+		//same size except the last, same peer
+		if(msgs[i].len<=0 || msgs[i].len>size || total+msgs[i].len>NET_UDP_GSO_LEN
+			|| msgs[i].addr.sin_family!=msgs[0].addr.sin_family
+			|| msgs[i].addr.sin_port!=msgs[0].addr.sin_port
+			|| msgs[i].addr.sin_addr.s_addr!=msgs[0].addr.sin_addr.s_addr) {
+			break;
+		}
+		total += msgs[i].len;
+		if(msgs[i].len<size) {
+			++i;
+			break;
+		}
+	}
+
+	return i;
+}
+#endif
+
+int socket_send_udp_batch(SOCKET s, const struct udp_msg *msgs, int cnt, int gso)
+{
+	int i, total = 0;
+#ifdef _WIN32
+	int ret;
+#else
+	int j, k, n, ret;
+	struct mmsghdr hdrs[NET_UDP_BATCH_MAX];
+	struct iovec iovs[NET_UDP_SEND_MAX];
+	int segs[NET_UDP_BATCH_MAX];
+  #ifdef UDP_SEGMENT
+	struct cmsghdr *cm;
+	char ctrls[NET_UDP_BATCH_MAX][CMSG_SPACE(sizeof(unsigned short))];
+  #endif
+#endif //_WIN32
+
+	if(NULL==msgs || cnt<=0) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+#ifdef _WIN32
+	(void)gso; //use variable only for compiler
+	for(i=0; i<cnt; ++i) {
+		ret = sendto(s, msgs[i].buf, msgs[i].len, 0,
+				(AF_INET==msgs[i].addr.sin_family) ? (const struct sockaddr*)&msgs[i].addr : NULL,
+				(AF_INET==msgs[i].addr.sin_family) ? sizeof(msgs[i].addr) : 0);
+		if(SOCKET_ERROR==ret) {
+			break;
+		}
+	}
+	total = i;
+#else
+	while(total<cnt) {
+		memset(hdrs, 0, sizeof(hdrs));
+		for(i=total, n=0, k=0; i<cnt && n<NET_UDP_BATCH_MAX && k<NET_UDP_SEND_MAX; ++n) {
+			segs[n] = 1;
+  #ifdef UDP_SEGMENT
+			if(gso && msgs[i].len>0) {
+				segs[n] = socket_udp_gso_count(msgs+i, (cnt-i < NET_UDP_SEND_MAX-k) ? (cnt-i) : (NET_UDP_SEND_MAX-k));
+			}
+			if(segs[n]>1) {
+				//the kernel splits data into datagrams of gso size
+				hdrs[n].msg_hdr.msg_control = ctrls[n];
+				hdrs[n].msg_hdr.msg_controllen = sizeof(ctrls[n]);
+				cm = CMSG_FIRSTHDR(&hdrs[n].msg_hdr);
+				cm->cmsg_level = SOL_UDP;
+				cm->cmsg_type = UDP_SEGMENT;
+				cm->cmsg_len = CMSG_LEN(sizeof(unsigned short));
+				*(unsigned short*)CMSG_DATA(cm) = (unsigned short)msgs[i].len;
+			}
+  #endif
+			if(AF_INET==msgs[i].addr.sin_family) {
+				hdrs[n].msg_hdr.msg_name = (void*)&msgs[i].addr;
+				hdrs[n].msg_hdr.msg_namelen = sizeof(msgs[i].addr);
+			}
+			hdrs[n].msg_hdr.msg_iov = &iovs[k];
+			hdrs[n].msg_hdr.msg_iovlen = segs[n];
+			for(j=0; j<segs[n]; ++j, ++i, ++k) {
+				iovs[k].iov_base = msgs[i].buf;
+				iovs[k].iov_len = msgs[i].len;
+			}
+		}
+
+		//sendmmsg (since Linux 3.0)
+		ret = sendmmsg(s, hdrs, n, MSG_DONTWAIT);
+		if(ret<0) {
+			if(EINTR==errno) {
+				continue;
+			}
+			if(gso && segs[0]>1 && (EIO==errno || EINVAL==errno)) {
+				//gso is not supported by kernel or device
+				gso = 0;
+				continue;
+			}
+			if(0==total && EAGAIN!=errno && EWOULDBLOCK!=errno) {
+				net_errno = NET_ERROR_SEND;
+				return -1;
+			}
+			//socket send buffer is full, or the error is returned by next call
+			break;
+		}
+		for(j=0; j<ret; ++j) {
+			total += segs[j];
+		}
+	}
+#endif //_WIN32
+
+	return total;
+}
+
+int socket_recv_udp_batch(SOCKET s, struct udp_msg *msgs, int cnt)
+{
+	int i, ret;
+#ifdef _WIN32
+	int addr_len;
+#else
+	struct mmsghdr hdrs[NET_UDP_BATCH_MAX];
+	struct iovec iovs[NET_UDP_BATCH_MAX];
+  #ifdef UDP_GRO
+	struct cmsghdr *cm;
+	char ctrls[NET_UDP_BATCH_MAX][CMSG_SPACE(sizeof(int))];
+  #endif
+#endif //_WIN32
+
+	if(NULL==msgs || cnt<=0) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+	if(cnt>NET_UDP_BATCH_MAX) {
+		cnt = NET_UDP_BATCH_MAX;
+	}
+
+#ifdef _WIN32
+	for(i=0; i<cnt; ++i) {
+		addr_len = sizeof(msgs[i].addr);
+		ret = recvfrom(s, msgs[i].buf, msgs[i].size, 0, (struct sockaddr*)&msgs[i].addr, &addr_len);
+		if(SOCKET_ERROR==ret) {
+			ret = WSAGetLastError();
+			if(WSAEMSGSIZE==ret) {
+				msgs[i].len = msgs[i].size;
+				msgs[i].trunc = 1;
+				continue;
+			}
+			if(WSAEWOULDBLOCK==ret || i>0) {
+				//return received datagrams, the error is returned by next call
+				break;
+			}
+			net_errno = NET_ERROR_RECV;
+			return -1;
+		}
+		msgs[i].len = ret;
+		msgs[i].trunc = 0;
+		msgs[i].seg = 0;
+	}
+	return i;
+#else
+	memset(hdrs, 0, sizeof(struct mmsghdr)*cnt);
+	for(i=0; i<cnt; ++i) {
+		iovs[i].iov_base = msgs[i].buf;
+		iovs[i].iov_len = msgs[i].size;
+		hdrs[i].msg_hdr.msg_iov = &iovs[i];
+		hdrs[i].msg_hdr.msg_iovlen = 1;
+		hdrs[i].msg_hdr.msg_name = &msgs[i].addr;
+		hdrs[i].msg_hdr.msg_namelen = sizeof(msgs[i].addr);
+  #ifdef UDP_GRO
+		hdrs[i].msg_hdr.msg_control = ctrls[i];
+		hdrs[i].msg_hdr.msg_controllen = sizeof(ctrls[i]);
+  #endif
+	}
+
+	do {
+		//recvmmsg (since Linux 2.6.33)
+		ret = recvmmsg(s, hdrs, cnt, MSG_DONTWAIT, NULL);
+	}while(ret<0 && EINTR==errno);
+
+	if(ret<0) {
+		if(EAGAIN==errno || EWOULDBLOCK==errno) {
+			return 0;
+		}
+		net_errno = NET_ERROR_RECV;
+		return -1;
+	}
+	for(i=0; i<ret; ++i) {
+		msgs[i].len = (int)hdrs[i].msg_len;
+		msgs[i].trunc = (hdrs[i].msg_hdr.msg_flags&MSG_TRUNC) ? 1 : 0;
+		msgs[i].seg = 0;
+  #ifdef UDP_GRO
+		//segment size of coalesced datagrams
+		for(cm=CMSG_FIRSTHDR(&hdrs[i].msg_hdr); cm; cm=CMSG_NXTHDR(&hdrs[i].msg_hdr, cm)) {
+			if(SOL_UDP==cm->cmsg_level && UDP_GRO==cm->cmsg_type) {
+				msgs[i].seg = *(int*)CMSG_DATA(cm);
+				break;
+			}
+		}
+  #endif
+	}
+	return ret;
+#endif //_WIN32
+}
+
+int socket_recv_udp_from(SOCKET s, struct sockaddr_in *peer_addr, char *buf, int len)
+{
+	socklen_t addr_len = sizeof(struct sockaddr_in);
+
+	if(NULL==peer_addr || NULL==buf || 0==len) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	return recvfrom(s, buf, len, 0, (struct sockaddr*)peer_addr, &addr_len);
+}
+
+int socket_recv_udp(SOCKET s, /*struct sockaddr *peer_addr,*/ char *buf, int len)
+{
+	int addr_len;
+
+	if(/*NULL==peer_addr ||*/ NULL==buf || 0==len) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	addr_len = sizeof(struct sockaddr);
+
+	return recvfrom(s, buf, len, 0, /*peer_addr*/NULL, /*&addr_len*/0);
+}
+
+void socket_close(SOCKET s)
+{
+#ifdef _WIN32
+	closesocket(s);
+#else
+	close(s);
+#endif //_WIN32
+}
+
+int socket_set_nonblock(SOCKET s)
+{
+	int flag;
+#ifdef _WIN32
+	/*Set the socket I/O mode: In this case FIONBIO
+	enables or disables the blocking mode for the
+	socket based on the numerical value of iMode.
+	If iMode = 0, blocking is enabled;
+	If iMode != 0, non-blocking mode is enabled.
+	*/
+	flag = 1;
+	return (NO_ERROR == ioctlsocket(s, FIONBIO, &flag)) ? 0 : -1;
+#else
+	flag = fcntl(s, F_GETFL);
+	flag |= O_NONBLOCK;
+
+	return (0==fcntl(s, F_SETFL, flag)) ? 0 : -1;
+#endif //_WIN32
+}
+
+int socket_set_zerocopy(SOCKET s)
+{
+#ifdef NET_HAVE_ZEROCOPY
+	int flag = 1;
+	//SO_ZEROCOPY (since Linux 4.14)
+	return (0==setsockopt(s, SOL_SOCKET, SO_ZEROCOPY, &flag, sizeof(flag))) ? 0 : -1;
+#else
+	(void)s; //use variable only for compiler
+	return -1;
+#endif //NET_HAVE_ZEROCOPY
+}
+
+int socket_set_udp_gro(SOCKET s, int enable)
+{
+#if !defined(_WIN32) && defined(UDP_GRO)
+	//UDP_GRO (since Linux 5.0)
+	return (0==setsockopt(s, SOL_UDP, UDP_GRO, &enable, sizeof(enable))) ? 0 : -1;
+#else
+	(void)s; (void)enable; //use variable only for compiler
+	return -1;
+#endif
+}
+
+int socket_set_rcvlowat(SOCKET s, int bytes)
+{
+#ifndef _WIN32
+	//honored by poll/epoll since Linux 2.6.28
+	return (0==setsockopt(s, SOL_SOCKET, SO_RCVLOWAT, &bytes, sizeof(bytes))) ? 0 : -1;
+#else
+	(void)s; (void)bytes; //use variable only for compiler
+	return -1;
+#endif //_WIN32
+}
+
+int socket_send_tcp_zerocopy(SOCKET s, const char *data, int len)
+{
+#ifdef NET_HAVE_ZEROCOPY
+	int ret;
+	if(NULL==data || 0==len) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	do {
+		ret = send(s, data, len, MSG_NOSIGNAL|MSG_ZEROCOPY);
+	}while(ret<0 && EINTR==errno);
+
+	if(ret<0 && (EAGAIN==errno || EWOULDBLOCK==errno)) {
+		//socket send buffer is full, not retry here
+		return 0;
+	}
+	if(ret<0) {
+		//ENOBUFS, too many notifications are not read
+		net_errno = NET_ERROR_SEND;
+	}
+	return ret;
+#else
+	return socket_send_tcp(s, data, len);
+#endif //NET_HAVE_ZEROCOPY
+}
+
+int socket_recv_zerocopy(SOCKET s, unsigned int *lo, unsigned int *hi, int *copied)
+{
+#ifdef NET_HAVE_ZEROCOPY
+	int ret;
+	struct msghdr msg;
+	struct cmsghdr *cm;
+	struct sock_extended_err *serr;
+	char control[128];
+
+	if(NULL==lo || NULL==hi || NULL==copied) {
+		net_errno = NET_ERROR_INVALID_PARAM;
+		return -1;
+	}
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+	ret = recvmsg(s, &msg, MSG_ERRQUEUE);
+	if(ret<0) {
+		if(EAGAIN==errno || EWOULDBLOCK==errno || EINTR==errno) {
+			//error queue is empty
+			return 0;
+		}
+		net_errno = NET_ERROR_RECV;
+		return -1;
+	}
+
+	for(cm=CMSG_FIRSTHDR(&msg); cm; cm=CMSG_NXTHDR(&msg, cm)) {
+		if(!((SOL_IP==cm->cmsg_level && IP_RECVERR==cm->cmsg_type)
+			|| (SOL_IPV6==cm->cmsg_level && IPV6_RECVERR==cm->cmsg_type))) {
+			continue;
+		}
+		serr = (struct sock_extended_err*)CMSG_DATA(cm);
+		if(SO_EE_ORIGIN_ZEROCOPY!=serr->ee_origin || 0!=serr->ee_errno) {
+			continue;
+		}
+		//completed range of send calls
+		*lo = serr->ee_info;
+		*hi = serr->ee_data;
+		*copied = (serr->ee_code&SO_EE_CODE_ZEROCOPY_COPIED) ? 1 : 0;
+		return 1;
+	}
+
+	//other message, the caller go on reading
+	return 2;
+#else
+	(void)s; (void)lo; (void)hi; (void)copied; //use variable only for compiler
+	return 0;
+#endif //NET_HAVE_ZEROCOPY
+}
+
+int socket_get_error(SOCKET s)
+{
+	int error = 0;
+	socklen_t len = sizeof(error);
+
+	if(0!=getsockopt(s, SOL_SOCKET, SO_ERROR, (char*)&error, &len)) {
+		return -1;
+	}
+
+	return error;
+}
+
+int socket_get_local_addr(SOCKET s, struct sockaddr_in *addr)
+{
+	socklen_t addr_len = sizeof(struct sockaddr);
+	//On success, zero is returned.  On error, -1 is returned
+	return (addr) ? getsockname(s, (struct sockaddr*)addr, &addr_len) : -1;
+}
+
+int socket_get_peer_addr(SOCKET s, struct sockaddr_in *addr)
+{
+	socklen_t addr_len = sizeof(struct sockaddr);
+	//On success, zero is returned.  On error, -1 is returned
+	return (addr) ? getpeername(s, (struct sockaddr*)addr, &addr_len) : -1;
+}
+
+char* socket_get_host_ip(const char *host)
+{
+	unsigned int ipvalue;
+
+	if(socket_resolve_host(host, &ipvalue, 1)<=0) {
+		return NULL;
+	}
+
+	return socket_convert_val2ip(ipvalue);
+}
+
+int socket_resolve_host(const char *host, unsigned int *ips, int cnt)
+{
+	int i, ret;
+	int n = 0;
+	unsigned int ipvalue;
+	struct addrinfo hints;
+	struct addrinfo *res, *ai;
+
+	if(NULL==host || '\0'==*host || NULL==ips || cnt<=0) {
+		return -1;
+	}
+
+	memset(&hints, 0, sizeof(struct addrinfo));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP; //0 any protocol
+
+	if(0!=(ret=getaddrinfo(host, NULL, &hints, &res))) {
+		LOG_WARN("[socket_api] getaddrinfo(host=%s) failed errno=%d,%s", host, ret, gai_strerror(ret));
+		return -1;
+	}
+	for(ai=res; ai && n<cnt; ai=ai->ai_next) {
+		//struct sockaddr
+		ipvalue = ((struct sockaddr_in*)ai->ai_addr)->sin_addr.s_addr;
+		for(i=0; i<n && ips[i]!=ipvalue; ++i) {
+		}
+		if(i==n) {
+			ips[n++] = ipvalue;
+		}
+	}
+	//the list is freed once
+	freeaddrinfo(res);
+
+	return (n>0) ? (n) : (-1);
+}
+
+unsigned int socket_get_netcard_ip(const char *eth)
+{
+	SOCKET s;
+	unsigned int ip=0;
+	struct ifreq ifr;
+
+	if(NULL==eth || '\0'==*eth) {
+		return 0;
+	}
+
+	if( (s = socket(AF_INET, SOCK_STREAM, 0)) != -1) {
+		memset(&ifr, 0, sizeof(struct ifreq));
+		strncpy(ifr.ifr_name, eth, sizeof(ifr.ifr_name)-1);
+		
+		if(0==ioctl(s, SIOCGIFADDR, &ifr)) {
+			//struct sockaddr, ifr.ifr_addr
+			//equal struct sockaddr_in
+			ip = ((struct sockaddr_in*)&ifr.ifr_addr)->sin_addr.s_addr;
+		}
+		socket_close(s);
+	} else {
+		LOG_WARN("[socket_api] socket failed errno=%d", errno);
+	}
+
+	return ip;
+}
+
+unsigned int socket_convert_ip2val(const char *ip)
+{
+	struct in_addr ia;
+
+	if(NULL==ip || '\0'==*ip) {
+		return -1;
+	}
+
+	if(0==inet_aton(ip, &ia)) {
+		//returns non-zero if the address is valid, zero if not
+		LOG_WARN("[socket_api] inet_aton(%s) failed", ip);
+		return -1;
+	}
+
+	return ia.s_addr;
+	//return inet_addr(ip).s_addr;
+}
+
+char* socket_convert_val2ip(unsigned int ipval)
+{
+	/*typedef uint32_t in_addr_t;
+	struct in_addr {
+		in_addr_t s_addr;
+	};
+	*/
+	struct in_addr ia;
+	ia.s_addr = ipval;
+
+	//The string is returned in a statically allocated buffer, 
+	// which subsequent calls will overwrite.
+	return inet_ntoa(ia);
+}
+
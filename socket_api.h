@@ -1,199 +1,411 @@
-/**********************************************************
-* file: socket_api.h
-* brief: os socket api
-* 
-* author: qk
-* email: 
-* date: 2018-08
-* modify date: 
-**********************************************************/
-
-#ifndef _SOCKET_API_H_
-#define _SOCKET_API_H_
-
-#ifdef _WIN32
-  #include<winsock2.h>           /*Ws2_32.lib*/
-  //#define SOCKET               /*typedef u_int SOCKET;*/
-  //#define INVALID_SOCKET (SOCKET)(~0)
-  //#define SOCKET_ERROR   (-1)
-#else
-  #include <sys/types.h>         /*See NOTES*/
-  #include <sys/socket.h>
-  #include <netinet/in.h>        /*inet_addr*/
-  #include <arpa/inet.h>
-  #define SOCKET int
-  #define INVALID_SOCKET (-1)    /*create*/
-  #define SOCKET_ERROR   (-1)    /*send*/
-#endif //_WIN32
-
-#include "net_error.h"
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/**********************************************************
- * brief: init socket system envirenment
- * input: None
- *
- * return: -1 error, 0 ok
- *********************************************************/
-int socket_init_env();
-
-/**********************************************************
- * brief: release socket envirenment
- * input: None
- *
- * return: None
- *********************************************************/
-void socket_release_env();
-
-/**********************************************************
- * brief: create/connect-to tcp model server
- * input: ip, ip v4 string, such as "xxx.xxx.xxx.xxx"
- *            if null, create tcp server that listen at port
- *        port, peer server port or listening port
- *
- * return: INVALID_SOCKET error, other ok
- *         NET_ERROR_MALLOC_SOCKET
- *         NET_ERROR_SET_NONBLOCK
- *         NET_ERROR_BIND
- *********************************************************/
-SOCKET socket_create_tcp(const char *ip, unsigned short port);
-
-/**********************************************************
- * brief: create/connect-to udp model server
- * input: ip, ip v4 string, such as "xxx.xxx.xxx.xxx"
- *            if null, create udp server that listen at port
- *        port, peer server port or listening port
- *
- * return: INVALID_SOCKET error, other value ok
- *********************************************************/
-SOCKET socket_create_udp(const char *ip, unsigned short port);
-
-/**********************************************************
- * brief: accept client from listenning socket s
- * input: s, listenning SOCKET
- *        c, client SOCKET returned
- *        addr, client addr
- *
- * return: -1 error, 0 ok
- *********************************************************/
-int socket_accept_client(SOCKET s, SOCKET *c, struct sockaddr *addr);
-
-/**********************************************************
- * brief: send data to tcp server
- * input: s, created SOCKET
- *        data, will be sent data
- *        len, data length
- *
- * return: SOCKET_ERROR error, >0 the length have sent
- *********************************************************/
-int socket_send_tcp(SOCKET s, const char *data, int len);
-
-/**********************************************************
- * brief: recv data to tcp server
- * input: s, created SOCKET
- *        buf, buffer for receiving data
- *        len, buf length
- *
- * return: SOCKET_ERROR error, >0 the length have received
- *         =0, if the connection has been gracefully closed
- *********************************************************/
-int socket_recv_tcp(SOCKET s, char *buf, int len);
-
-/**********************************************************
- * brief: send data to udp server
- * input: s, created SOCKET, have connected to server
- *        peer_addr, client addr send to
- *        data, will be sent data
- *        len, data length
- *
- * return: SOCKET_ERROR error, >0 the length have sent
- *********************************************************/
-int socket_send_udp(SOCKET s, /*struct sockaddr *peer_addr,*/ const char *data, int len);
-
-/**********************************************************
- * brief: recv data to udp server
- * input: s, created SOCKET
- *        peer_addr, peer addr recvfrom
- *        buf, buffer for receiving data
- *        len, buf length
- *
- * return: SOCKET_ERROR error, >0 the length have received
- *         =0, if the connection has been gracefully closed
- *********************************************************/
-int socket_recv_udp(SOCKET s, /*struct sockaddr *peer_addr,*/ char *buf, int len);
-
-/**********************************************************
- * brief: close socket
- * input: s, created SOCKET
- *
- * return: None
- *********************************************************/
-void socket_close(SOCKET s);
-
-/**********************************************************
- * brief: set socket flag with nonblock
- * input: s, created SOCKET
- *
- * return: 0 ok, -1 error
- *********************************************************/
-int socket_set_nonblock(SOCKET s);
-
-/**********************************************************
- * brief: get local socket addr relative to s
- * input: s, created SOCKET
- *        addr, buffer for storing the addr info
- *
- * return: 0 ok, -1 error
- *********************************************************/
-int socket_get_local_addr(SOCKET s, struct sockaddr_in *addr);
-
-/**********************************************************
- * brief: get peer socket addr relative to s
- * input: s, created SOCKET
- *        addr, buffer for storing the addr info
- *
- * return: 0 ok, -1 error
- *********************************************************/
-int socket_get_peer_addr(SOCKET s, struct sockaddr_in *addr);
-
-/**********************************************************
- * brief: get domain host ip string
- * input: host, domain string
- *
- * return: NULL error, other ok
- *********************************************************/
-char* socket_get_host_ip(const char *host);
-
-/**********************************************************
- * brief: get local netcard ip value
- * input: eth, netcard name
- *
- * return: 0 error, other ip value
- *********************************************************/
-unsigned int socket_get_netcard_ip(const char *eth);
-
-/**********************************************************
- * brief: convert ip string to integer
- * input: ip, ip string
- *
- * return: ip integer value
- *********************************************************/
-unsigned int socket_convert_ip2val(const char *ip);
-
-/**********************************************************
- * brief: convert ip integer value to string
- * input: ipval, ip integer value
- *
- * return: ip string
- *********************************************************/
-char* socket_convert_val2ip(unsigned int ipval);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif//_SOCKET_API_H_
-
+/**********************************************************
+* file: socket_api.h
+* brief: os socket api
+* 
+* author: qk
+* email: 
+* date: 2018-08
+* modify date: 
+**********************************************************/
+
+#ifndef _SOCKET_API_H_
+#define _SOCKET_API_H_
+
+#ifdef _WIN32
+  #include<winsock2.h>           /*Ws2_32.lib*/
+  //#define SOCKET               /*typedef u_int SOCKET;*/
+  //#define INVALID_SOCKET (SOCKET)(~0)
+  //#define SOCKET_ERROR   (-1)
+#else
+  #include <sys/types.h>         /*See NOTES*/
+  #include <sys/socket.h>
+  #include <netinet/in.h>        /*inet_addr*/
+  #include <arpa/inet.h>
+  #define SOCKET int
+  #define INVALID_SOCKET (-1)    /*create*/
+  #define SOCKET_ERROR   (-1)    /*send*/
+  #include <sys/uio.h>           /*struct iovec*/
+#endif //_WIN32
+
+#ifdef _WIN32
+//scatter/gather buffer, same as posix
+struct iovec {
+	void *iov_base;
+	size_t iov_len;
+};
+#endif //_WIN32
+
+//max count of iovec sent by one call
+#define NET_IOV_MAX (64)
+//max count of datagrams received by one call
+#define NET_UDP_BATCH_MAX (64)
+
+//datagram of batch receiving/sending
+struct udp_msg {
+	char *buf;  //buffer of datagram
+	int size;   //buffer size, receiving only
+	int len;    //datagram len, returned by receiving
+	int trunc;  //return 1 if datagram is larger than size and truncated, receiving only
+	int seg;    //return segment size if buf is coalesced datagrams of udp gro, 0 if not
+	struct sockaddr_in addr; //peer address, returned by receiving,
+	                         //sin_family 0 for connected peer when sending
+};
+
+#include "net_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************
+ * brief: init socket system envirenment
+ * input: None
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int socket_init_env();
+
+/**********************************************************
+ * brief: release socket envirenment
+ * input: None
+ *
+ * return: None
+ *********************************************************/
+void socket_release_env();
+
+/**********************************************************
+ * brief: create/connect-to tcp model server
+ * input: ip, ip v4 string, such as "xxx.xxx.xxx.xxx"
+ *            if null, create tcp server that listen at port
+ *        port, peer server port or listening port
+ *
+ * return: INVALID_SOCKET error, other ok
+ *         NET_ERROR_MALLOC_SOCKET
+ *         NET_ERROR_SET_NONBLOCK
+ *         NET_ERROR_BIND
+ *********************************************************/
+SOCKET socket_create_tcp(const char *ip, unsigned short port);
+
+/**********************************************************
+ * brief: create/connect-to tcp model server with listening
+ *        queue length
+ * input: ip, ip v4 string, such as "xxx.xxx.xxx.xxx"
+ *            if null, create tcp server that listen at port
+ *        port, peer server port or listening port
+ *        backlog, listening queue length, <=0 default SOMAXCONN
+ *
+ * return: INVALID_SOCKET error, other ok
+ *********************************************************/
+SOCKET socket_create_tcp_ex(const char *ip, unsigned short port, int backlog);
+
+/**********************************************************
+ * brief: connect to tcp server without waiting for completion,
+ *        the socket is writable when the connection completes,
+ *        and socket_get_error gets the result then
+ * input: ip, ip v4 string, such as "xxx.xxx.xxx.xxx"
+ *        port, peer server port
+ *        fastopen, 1 TCP_FASTOPEN_CONNECT if supported, the SYN is
+ *                  sent with the first data and the socket is
+ *                  writable at once
+ *        pending, 1 returned if the connection is in progress
+ *
+ * return: INVALID_SOCKET error, other nonblock SOCKET
+ *         NET_ERROR_INVALID_PARAM
+ *         NET_ERROR_MALLOC_SOCKET
+ *         NET_ERROR_SET_NONBLOCK
+ *         NET_ERROR_CONNECT
+ *********************************************************/
+SOCKET socket_connect_nonblock(const char *ip, unsigned short port, int fastopen, int *pending);
+
+/**********************************************************
+ * brief: create/connect-to udp model server
+ * input: ip, ip v4 string, such as "xxx.xxx.xxx.xxx"
+ *            if null, create udp server that listen at port
+ *        port, peer server port or listening port
+ *
+ * return: INVALID_SOCKET error, other value ok
+ *********************************************************/
+SOCKET socket_create_udp(const char *ip, unsigned short port);
+
+/**********************************************************
+ * brief: accept client from listenning socket s
+ * input: s, listenning SOCKET
+ *        c, client SOCKET returned
+ *        addr, client addr
+ *
+ * return: -1 error, 0 ok
+ *********************************************************/
+int socket_accept_client(SOCKET s, SOCKET *c, struct sockaddr *addr);
+
+/**********************************************************
+ * brief: accept nonblock client from nonblock listenning socket s
+ * input: s, listenning SOCKET
+ *        c, nonblock client SOCKET returned
+ *        addr, client addr
+ *
+ * return: -3 the client aborted, -2 no client, -1 error, 0 ok
+ *********************************************************/
+int socket_accept_nonblock(SOCKET s, SOCKET *c, struct sockaddr_in *addr);
+
+/**********************************************************
+ * brief: send data to tcp server, not wait if socket is nonblock
+ * input: s, created SOCKET
+ *        data, will be sent data
+ *        len, data length
+ *
+ * return: SOCKET_ERROR error, >=0 the length have sent,
+ *         0 if the socket send buffer is full
+ *********************************************************/
+int socket_send_tcp(SOCKET s, const char *data, int len);
+
+/**********************************************************
+ * brief: gather send data to tcp server, not wait if socket is nonblock
+ * input: s, created SOCKET
+ *        iov, buffers of will be sent data
+ *        cnt, count of iov, only first NET_IOV_MAX are sent
+ *
+ * return: SOCKET_ERROR error, >=0 the length have sent,
+ *         0 if the socket send buffer is full
+ *********************************************************/
+int socket_send_tcpv(SOCKET s, const struct iovec *iov, int cnt);
+
+/**********************************************************
+ * brief: recv data to tcp server
+ * input: s, created SOCKET
+ *        buf, buffer for receiving data
+ *        len, buf length
+ *
+ * return: SOCKET_ERROR error, >0 the length have received
+ *         =0, if the connection has been gracefully closed
+ *********************************************************/
+int socket_recv_tcp(SOCKET s, char *buf, int len);
+
+/**********************************************************
+ * brief: send data to udp server
+ * input: s, created SOCKET, have connected to server
+ *        peer_addr, client addr send to
+ *        data, will be sent data
+ *        len, data length
+ *
+ * return: SOCKET_ERROR error, >0 the length have sent
+ *********************************************************/
+int socket_send_udp(SOCKET s, /*struct sockaddr *peer_addr,*/ const char *data, int len);
+
+/**********************************************************
+ * brief: send data to udp peer
+ * input: s, created SOCKET
+ *        peer_addr, peer addr send to
+ *        data, will be sent data
+ *        len, data length
+ *
+ * return: SOCKET_ERROR error, >0 the length have sent
+ *********************************************************/
+int socket_send_udp_to(SOCKET s, const struct sockaddr_in *peer_addr, const char *data, int len);
+
+/**********************************************************
+ * brief: gather send one datagram to udp peer
+ * input: s, created SOCKET
+ *        peer_addr, peer addr send to, NULL if have connected to server
+ *        iov, buffers of will be sent data
+ *        cnt, count of iov, 0<cnt<=NET_IOV_MAX
+ *
+ * return: SOCKET_ERROR error, >0 the length have sent
+ *********************************************************/
+int socket_send_udpv(SOCKET s, const struct sockaddr_in *peer_addr, const struct iovec *iov, int cnt);
+
+/**********************************************************
+ * brief: recv data to udp server
+ * input: s, created SOCKET
+ *        peer_addr, peer addr recvfrom
+ *        buf, buffer for receiving data
+ *        len, buf length
+ *
+ * return: SOCKET_ERROR error, >0 the length have received
+ *         =0, if the connection has been gracefully closed
+ *********************************************************/
+int socket_recv_udp(SOCKET s, /*struct sockaddr *peer_addr,*/ char *buf, int len);
+
+/**********************************************************
+ * brief: recv data from udp peer
+ * input: s, created SOCKET
+ *        peer_addr, return peer addr recvfrom
+ *        buf, buffer for receiving data
+ *        len, buf length
+ *
+ * return: SOCKET_ERROR error, >=0 the length have received
+ *********************************************************/
+int socket_recv_udp_from(SOCKET s, struct sockaddr_in *peer_addr, char *buf, int len);
+
+/**********************************************************
+ * brief: recv datagrams as many as possible by one call, not wait
+ * input: s, created nonblock SOCKET
+ *        msgs, buffers of datagrams, return datagrams
+ *        cnt, count of msgs, only first NET_UDP_BATCH_MAX are used
+ *
+ * return: -1 error, >=0 count of received datagrams
+ *********************************************************/
+int socket_recv_udp_batch(SOCKET s, struct udp_msg *msgs, int cnt);
+
+/**********************************************************
+ * brief: send datagrams as many as possible, not wait
+ * input: s, created nonblock SOCKET
+ *        msgs, datagrams, buf/len/addr are used
+ *        cnt, count of msgs
+ *        gso, 1 send datagrams of same size to same peer by
+ *             UDP_SEGMENT if supported, 0 not
+ *
+ * return: -1 error, >=0 count of sent datagrams, the left are
+ *         not sent if socket send buffer is full or error
+ *********************************************************/
+int socket_send_udp_batch(SOCKET s, const struct udp_msg *msgs, int cnt, int gso);
+
+/**********************************************************
+ * brief: close socket
+ * input: s, created SOCKET
+ *
+ * return: None
+ *********************************************************/
+void socket_close(SOCKET s);
+
+/**********************************************************
+ * brief: set socket flag with nonblock
+ * input: s, created SOCKET
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int socket_set_nonblock(SOCKET s);
+
+/**********************************************************
+ * brief: enable zerocopy send on tcp socket, linux only
+ * input: s, created SOCKET
+ *
+ * return: 0 ok, -1 error or not supported
+ *********************************************************/
+int socket_set_zerocopy(SOCKET s);
+
+/**********************************************************
+ * brief: enable/disable udp gro receiving, linux only, one
+ *        received udp_msg may be coalesced datagrams from same
+ *        peer and udp_msg.seg is the size of them except the last
+ * input: s, created udp SOCKET
+ *        enable, 1 enable, 0 disable
+ *
+ * return: 0 ok, -1 error or not supported
+ *********************************************************/
+int socket_set_udp_gro(SOCKET s, int enable);
+
+/**********************************************************
+ * brief: set the min bytes in receiving buffer that make tcp
+ *        socket readable, poll/epoll do not wake up for less
+ * input: s, tcp SOCKET
+ *        bytes, min bytes, 1 is default
+ *
+ * return: 0 ok, -1 error or not supported
+ *********************************************************/
+int socket_set_rcvlowat(SOCKET s, int bytes);
+
+/**********************************************************
+ * brief: send data with MSG_ZEROCOPY, the data must be kept
+ *        until completion is read by socket_recv_zerocopy,
+ *        same as socket_send_tcp if not supported
+ * input: s, SOCKET enabled by socket_set_zerocopy
+ *        data, will be sent data
+ *        len, data length
+ *
+ * return: SOCKET_ERROR error, >=0 the length have sent,
+ *         0 if the socket send buffer is full
+ *********************************************************/
+int socket_send_tcp_zerocopy(SOCKET s, const char *data, int len);
+
+/**********************************************************
+ * brief: read one zerocopy completion from socket error queue,
+ *        the send calls numbered from lo to hi are completed,
+ *        every successful MSG_ZEROCOPY send call takes a number
+ *        from 0, the numbers wrap around, so hi may be less than lo
+ * input: s, SOCKET enabled by socket_set_zerocopy
+ *        lo, return first completed number
+ *        hi, return last completed number
+ *        copied, return 1 if the kernel copied data
+ *
+ * return: -1 error, 0 no message, 1 read one completion,
+ *         2 read other message
+ *********************************************************/
+int socket_recv_zerocopy(SOCKET s, unsigned int *lo, unsigned int *hi, int *copied);
+
+/**********************************************************
+ * brief: get and clear the pending error of socket, such as
+ *        the result of socket_connect_nonblock
+ * input: s, created SOCKET
+ *
+ * return: 0 no error, >0 error code, -1 failed to get it
+ *********************************************************/
+int socket_get_error(SOCKET s);
+
+/**********************************************************
+ * brief: get local socket addr relative to s
+ * input: s, created SOCKET
+ *        addr, buffer for storing the addr info
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int socket_get_local_addr(SOCKET s, struct sockaddr_in *addr);
+
+/**********************************************************
+ * brief: get peer socket addr relative to s
+ * input: s, created SOCKET
+ *        addr, buffer for storing the addr info
+ *
+ * return: 0 ok, -1 error
+ *********************************************************/
+int socket_get_peer_addr(SOCKET s, struct sockaddr_in *addr);
+
+/**********************************************************
+ * brief: get domain host ip string, blocking, the string is in
+ *        static buffer overwritten by next call
+ * input: host, domain string
+ *
+ * return: NULL error, other ok, the first ipv4 addr
+ *********************************************************/
+char* socket_get_host_ip(const char *host);
+
+/**********************************************************
+ * brief: resolve domain host to ipv4 addrs, blocking, thread safe,
+ *        /etc/hosts and dns are used as configured by system
+ * input: host, domain string or ip string
+ *        ips, buffer for ip values in network byte order
+ *        cnt, size of ips
+ *
+ * return: -1 error, >0 the number of ips, duplicates are removed
+ *********************************************************/
+int socket_resolve_host(const char *host, unsigned int *ips, int cnt);
+
+/**********************************************************
+ * brief: get local netcard ip value
+ * input: eth, netcard name
+ *
+ * return: 0 error, other ip value
+ *********************************************************/
+unsigned int socket_get_netcard_ip(const char *eth);
+
+/**********************************************************
+ * brief: convert ip string to integer
+ * input: ip, ip string
+ *
+ * return: ip integer value
+ *********************************************************/
+unsigned int socket_convert_ip2val(const char *ip);
+
+/**********************************************************
+ * brief: convert ip integer value to string
+ * input: ipval, ip integer value
+ *
+ * return: ip string
+ *********************************************************/
+char* socket_convert_val2ip(unsigned int ipval);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//_SOCKET_API_H_
+
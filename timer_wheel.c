@@ -0,0 +1,274 @@
+#include "timer_wheel.h"
+#include "mem_pool.h"
+#include "log.h"
+#include <string.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <time.h>
+#endif //_WIN32
+
+//level 1 has 256 slots of 1ms, level 2-5 have 64 slots
+#define TVR_BITS (8)
+#define TVN_BITS (6)
+#define TVR_SIZE (1<<TVR_BITS)
+#define TVN_SIZE (1<<TVN_BITS)
+#define TVR_MASK (TVR_SIZE-1)
+#define TVN_MASK (TVN_SIZE-1)
+#define TVN_LEVEL (4)
+//the max ticks from now
+#define MAX_TIMEOUT (0xffffffffULL)
+
+//slot index of level n(0-3) in tvn
+#define TVN_INDEX(j, n) (((j) >> (TVR_BITS + (n)*TVN_BITS)) & TVN_MASK)
+
+struct timer_wheel {
+	unsigned long long jiffies; //next tick to be handled
+	unsigned int count;
+	//circular list heads
+	struct timer_node tv1[TVR_SIZE];
+	struct timer_node tvn[TVN_LEVEL][TVN_SIZE];
+};
+
+static inline void list_init(struct timer_node *head)
+{
+	head->prev = head;
+	head->next = head;
+}
+
+static inline int list_empty(const struct timer_node *head)
+{
+	return head->next==head;
+}
+
+static inline void list_add_tail(struct timer_node *head, struct timer_node *tn)
+{
+	tn->prev = head->prev;
+	tn->next = head;
+	head->prev->next = tn;
+	head->prev = tn;
+}
+
+static inline void list_del(struct timer_node *tn)
+{
+	tn->prev->next = tn->next;
+	tn->next->prev = tn->prev;
+	tn->prev = NULL;
+	tn->next = NULL;
+}
+
+static void timer_wheel_insert(struct timer_wheel *tw, struct timer_node *tn)
+{
+	unsigned long long expire = tn->expire;
+	unsigned long long idx;
+	struct timer_node *head;
+
+	if(expire < tw->jiffies) {
+		//have expired, handle it at next tick
+		head = &tw->tv1[tw->jiffies & TVR_MASK];
+	} else {
+		idx = expire - tw->jiffies;
+		if(idx < TVR_SIZE) {
+			head = &tw->tv1[expire & TVR_MASK];
+		} else if(idx < (1ULL<<(TVR_BITS+TVN_BITS))) {
+			head = &tw->tvn[0][TVN_INDEX(expire, 0)];
+		} else if(idx < (1ULL<<(TVR_BITS+2*TVN_BITS))) {
+			head = &tw->tvn[1][TVN_INDEX(expire, 1)];
+		} else if(idx < (1ULL<<(TVR_BITS+3*TVN_BITS))) {
+			head = &tw->tvn[2][TVN_INDEX(expire, 2)];
+		} else {
+			if(idx > MAX_TIMEOUT) {
+				//re-inserted when it is cascaded
+				expire = tw->jiffies + MAX_TIMEOUT;
+			}
+			head = &tw->tvn[3][TVN_INDEX(expire, 3)];
+		}
+	}
+
+	list_add_tail(head, tn);
+}
+
+//move the timers of level n slot to lower levels
+static int timer_wheel_cascade(struct timer_wheel *tw, int n)
+{
+	int index = (int)TVN_INDEX(tw->jiffies, n);
+	struct timer_node list, *tn;
+
+	//take out the whole list, then re-insert them
+	if(list_empty(&tw->tvn[n][index])) {
+		return index;
+	}
+	list.next = tw->tvn[n][index].next;
+	list.prev = tw->tvn[n][index].prev;
+	list.next->prev = &list;
+	list.prev->next = &list;
+	list_init(&tw->tvn[n][index]);
+
+	while(!list_empty(&list)) {
+		tn = list.next;
+		list_del(tn);
+		timer_wheel_insert(tw, tn);
+	}
+
+	return index;
+}
+
+unsigned long long timer_wheel_now()
+{
+#ifdef _WIN32
+	return (unsigned long long)GetTickCount64();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec*1000 + ts.tv_nsec/1000000;
+#endif //_WIN32
+}
+
+struct timer_wheel* timer_wheel_create(unsigned long long now)
+{
+	int i, j;
+	struct timer_wheel *tw = (struct timer_wheel*)mem_pool_malloc(sizeof(struct timer_wheel));
+
+	if(NULL==tw) {
+		LOG_WARN("[timer_wheel] create failed, mem_pool_malloc failed.");
+		return NULL;
+	}
+
+	tw->jiffies = now;
+	tw->count = 0;
+	for(i=0;i<TVR_SIZE;++i) {
+		list_init(&tw->tv1[i]);
+	}
+	for(i=0;i<TVN_LEVEL;++i) {
+		for(j=0;j<TVN_SIZE;++j) {
+			list_init(&tw->tvn[i][j]);
+		}
+	}
+
+	return tw;
+}
+
+void timer_wheel_add(struct timer_wheel *tw, struct timer_node *tn, unsigned long long expire)
+{
+	tn->expire = expire;
+	timer_wheel_insert(tw, tn);
+	tw->count++;
+}
+
+void timer_wheel_del(struct timer_wheel *tw, struct timer_node *tn)
+{
+	if(tn->next) {
+		list_del(tn);
+		tw->count--;
+	}
+}
+
+int timer_wheel_pending(const struct timer_node *tn)
+{
+	return (NULL!=tn->next) ? 1 : 0;
+}
+
+struct timer_node* timer_wheel_expire(struct timer_wheel *tw, unsigned long long now)
+{
+	int n;
+	struct timer_node *head, *tn;
+
+	if(0==tw->count) {
+		//nothing to cascade, skip the idle ticks
+		if(now >= tw->jiffies) {
+			tw->jiffies = now+1;
+		}
+		return NULL;
+	}
+
+	while(tw->jiffies <= now) {
+		head = &tw->tv1[tw->jiffies & TVR_MASK];
+		while(!list_empty(head)) {
+			tn = head->next;
+			list_del(tn);
+			if(tn->expire > tw->jiffies) {
+				//the timeout was beyond the wheel range
+				timer_wheel_insert(tw, tn);
+				continue;
+			}
+			tw->count--;
+			return tn;
+		}
+
+		tw->jiffies++;
+		if(0==(tw->jiffies & TVR_MASK)) {
+			//level 1 wrapped, cascade from upper levels
+			for(n=0;n<TVN_LEVEL;++n) {
+				if(0!=timer_wheel_cascade(tw, n)) {
+					break;
+				}
+			}
+		}
+	}
+
+	return NULL;
+}
+
+struct timer_node* timer_wheel_pop(struct timer_wheel *tw)
+{
+	int i, j;
+	struct timer_node *tn = NULL;
+
+	if(0==tw->count) {
+		return NULL;
+	}
+
+	for(i=0;i<TVR_SIZE && NULL==tn;++i) {
+		if(!list_empty(&tw->tv1[i])) {
+			tn = tw->tv1[i].next;
+		}
+	}
+	for(i=0;i<TVN_LEVEL && NULL==tn;++i) {
+		for(j=0;j<TVN_SIZE && NULL==tn;++j) {
+			if(!list_empty(&tw->tvn[i][j])) {
+				tn = tw->tvn[i][j].next;
+			}
+		}
+	}
+
+	if(tn) {
+		list_del(tn);
+		tw->count--;
+	}
+	return tn;
+}
+
+int timer_wheel_next_timeout(struct timer_wheel *tw, unsigned long long now)
+{
+	unsigned long long i, idx;
+
+	if(0==tw->count) {
+		return -1;
+	}
+	if(tw->jiffies <= now) {
+		return 0;
+	}
+
+	//scan level 1 until it wraps, the upper levels are cascaded then
+	idx = tw->jiffies & TVR_MASK;
+	for(i=0;i<TVR_SIZE-idx;++i) {
+		if(!list_empty(&tw->tv1[idx+i])) {
+			break;
+		}
+	}
+
+	return (int)(tw->jiffies + i - now);
+}
+
+unsigned int timer_wheel_count(struct timer_wheel *tw)
+{
+	return tw->count;
+}
+
+void timer_wheel_destroy(struct timer_wheel *tw)
+{
+	if(tw) {
+		mem_pool_free(tw);
+	}
+}
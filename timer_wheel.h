@@ -0,0 +1,119 @@
+/**********************************************************
+* file: timer_wheel.h
+* brief: hierarchical timing wheel, O(1) add/del timer
+*        5 levels wheel with 1 millisecond tick, the max
+*        timeout is 2^32 milliseconds (about 49 days)
+* 
+* author: qk
+* email: 
+* date: 2026-10
+* modify date: 
+**********************************************************/
+
+#ifndef _TIMER_WHEEL_H_
+#define _TIMER_WHEEL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//timer node, embedded in user struct
+//it is not pending if next is NULL
+struct timer_node {
+	struct timer_node *prev;
+	struct timer_node *next;
+	unsigned long long expire; //milliseconds
+};
+
+/**********************************************************
+ * brief: get current monotonic time
+ * input: None
+ *
+ * return: milliseconds
+ *********************************************************/
+unsigned long long timer_wheel_now();
+
+/**********************************************************
+ * brief: create timer wheel
+ * input: now, current time from timer_wheel_now
+ *
+ * return: NULL error, other ok
+ *********************************************************/
+struct timer_wheel* timer_wheel_create(unsigned long long now);
+
+/**********************************************************
+ * brief: add timer node to wheel, the node must not be pending
+ * input: tw, timer wheel
+ *        tn, timer node
+ *        expire, absolute expire time in milliseconds
+ *
+ * return: None
+ *********************************************************/
+void timer_wheel_add(struct timer_wheel *tw, struct timer_node *tn, unsigned long long expire);
+
+/**********************************************************
+ * brief: delete timer node from wheel if it is pending
+ * input: tw, timer wheel
+ *        tn, timer node
+ *
+ * return: None
+ *********************************************************/
+void timer_wheel_del(struct timer_wheel *tw, struct timer_node *tn);
+
+/**********************************************************
+ * brief: check whether timer node is pending in wheel
+ * input: tn, timer node
+ *
+ * return: 1 pending, 0 not
+ *********************************************************/
+int timer_wheel_pending(const struct timer_node *tn);
+
+/**********************************************************
+ * brief: take out one expired timer node, call it repeatedly
+ *        until NULL to handle all the expired timers
+ * input: tw, timer wheel
+ *        now, current time from timer_wheel_now
+ *
+ * return: NULL no expired node, other expired node(not pending)
+ *********************************************************/
+struct timer_node* timer_wheel_expire(struct timer_wheel *tw, unsigned long long now);
+
+/**********************************************************
+ * brief: take out any pending timer node whether expired or
+ *        not, such as for freeing the nodes before destroy
+ * input: tw, timer wheel
+ *
+ * return: NULL no pending node, other node(not pending)
+ *********************************************************/
+struct timer_node* timer_wheel_pop(struct timer_wheel *tw);
+
+/**********************************************************
+ * brief: the time until the next timer may expire
+ * input: tw, timer wheel
+ *        now, current time from timer_wheel_now
+ *
+ * return: -1 no timer, >=0 milliseconds
+ *********************************************************/
+int timer_wheel_next_timeout(struct timer_wheel *tw, unsigned long long now);
+
+/**********************************************************
+ * brief: the number of pending timer nodes
+ * input: tw, timer wheel
+ *
+ * return: count
+ *********************************************************/
+unsigned int timer_wheel_count(struct timer_wheel *tw);
+
+/**********************************************************
+ * brief: destroy timer wheel, the pending nodes are not freed
+ * input: tw, timer wheel
+ *
+ * return: None
+ *********************************************************/
+void timer_wheel_destroy(struct timer_wheel *tw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//_TIMER_WHEEL_H_
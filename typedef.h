@@ -1,29 +1,29 @@
-/**********************************************************
-* file: typedef.h
-* brief: type define
-* 
-* author: qk
-* email: 
-* date: 2018-08
-* modify date: 
-**********************************************************/
-
-#ifndef _TYPEDEF_H_
-#define _TYPEDEF_H_
-
-#ifndef NULL
-#ifdef __cplusplus
-#define NULL 0
-#else
-#define NULL ((void*)0)
-#endif
-#endif
-#ifndef FALSE
-#define FALSE 0
-#endif
-#ifndef TRUE
-#define TRUE 1
-#endif
-
-#endif//_TYPEDEF_H_
-
+/**********************************************************
+* file: typedef.h
+* brief: type define
+* 
+* author: qk
+* email: 
+* date: 2018-08
+* modify date: 
+**********************************************************/
+
+#ifndef _TYPEDEF_H_
+#define _TYPEDEF_H_
+
+#ifndef NULL
+#ifdef __cplusplus
+#define NULL 0
+#else
+#define NULL ((void*)0)
+#endif
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+#ifndef TRUE
+#define TRUE 1
+#endif
+
+#endif//_TYPEDEF_H_
+
@@ -0,0 +1,331 @@
+#include "uring_api.h"
+
+#ifdef NET_HAVE_URING
+
+#include "mem_pool.h"
+#include "log.h"
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+//ring define, the pointers are in the mmaped area shared with kernel
+struct uring_t {
+	int fd;
+
+	//submission queue
+	unsigned int *sq_head;
+	unsigned int *sq_tail;
+	unsigned int *sq_mask;
+	unsigned int *sq_array;
+	struct io_uring_sqe *sqes;
+	unsigned int sq_local_tail; //got by uring_get_sqe, not submitted
+	unsigned int sq_entries;
+
+	//completion queue
+	unsigned int *cq_head;
+	unsigned int *cq_tail;
+	unsigned int *cq_mask;
+	struct io_uring_cqe *cqes;
+
+	void *sq_ring;
+	void *cq_ring;
+	size_t sq_ring_size;
+	size_t cq_ring_size;
+	size_t sqes_size;
+
+#ifdef NET_HAVE_URING_BUF
+	//provided buffers, the ring and buffers share one mmap
+	struct io_uring_buf_ring *br;
+	char *bufs;
+	size_t br_size;
+	unsigned int buf_count;
+	unsigned int buf_size;
+	unsigned short br_tail;
+#endif //NET_HAVE_URING_BUF
+};
+
+static inline int sys_io_uring_setup(unsigned int entries, struct io_uring_params *p)
+{
+	return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static inline int sys_io_uring_register(int fd, unsigned int opcode, void *arg, unsigned int nr_args)
+{
+	return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static inline int sys_io_uring_enter(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags, void *arg, size_t argsz)
+{
+	return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+//multishot poll and updating poll (since Linux 5.13) are rejected with EINVAL
+//by older kernel, updating a poll not existed returns ENOENT if supported
+static int uring_probe_poll(struct uring_t *u)
+{
+	int ret;
+	struct io_uring_sqe *sqe;
+	struct io_uring_cqe *cqe;
+
+	sqe = uring_get_sqe(u);
+	if(NULL==sqe) {
+		return -1;
+	}
+	sqe->opcode = IORING_OP_POLL_REMOVE;
+	sqe->fd = -1;
+	sqe->addr = (unsigned long long)(unsigned long)u;
+	sqe->len = IORING_POLL_UPDATE_EVENTS | IORING_POLL_ADD_MULTI;
+	sqe->poll32_events = POLLIN;
+	sqe->user_data = 0;
+	do {
+		ret = uring_enter(u, uring_flush_sq(u), 1, -1);
+	}while(-1==ret && EINTR==errno);
+	if(-1==ret || NULL==(cqe = uring_peek_cqe(u))) {
+		return -1;
+	}
+	ret = cqe->res;
+	uring_cq_advance(u, 1);
+
+	return (-EINVAL==ret) ? (-1) : (0);
+}
+
+struct uring_t* uring_create(unsigned int entries)
+{
+	struct uring_t *u;
+	struct io_uring_params p;
+	char *sq, *cq;
+
+	memset(&p, 0, sizeof(p));
+	u = (struct uring_t*)mem_pool_malloc(sizeof(struct uring_t));
+	if(NULL==u) {
+		LOG_WARN("[uring_api] uring create failed, mem_pool_malloc failed.");
+		return NULL;
+	}
+	memset(u, 0, sizeof(struct uring_t));
+
+	u->fd = sys_io_uring_setup(entries, &p);
+	if(-1==u->fd) {
+		LOG_WARN("[uring_api] uring create failed, io_uring_setup errno=%d.", errno);
+		mem_pool_free(u);
+		return NULL;
+	}
+	//timeout of waiting need IORING_ENTER_EXT_ARG (since Linux 5.11)
+	if(0==(p.features&IORING_FEAT_EXT_ARG) || 0==(p.features&IORING_FEAT_SINGLE_MMAP)) {
+		LOG_WARN("[uring_api] uring create failed, kernel features=0x%x not support.", p.features);
+		close(u->fd);
+		mem_pool_free(u);
+		return NULL;
+	}
+
+	//sq and cq ring share one mmap with IORING_FEAT_SINGLE_MMAP
+	u->sq_ring_size = p.sq_off.array + p.sq_entries*sizeof(unsigned int);
+	u->cq_ring_size = p.cq_off.cqes + p.cq_entries*sizeof(struct io_uring_cqe);
+	if(u->cq_ring_size > u->sq_ring_size) {
+		u->sq_ring_size = u->cq_ring_size;
+	}
+	u->sq_ring = mmap(NULL, u->sq_ring_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+	if(MAP_FAILED==u->sq_ring) {
+		LOG_WARN("[uring_api] uring create failed, mmap ring errno=%d.", errno);
+		close(u->fd);
+		mem_pool_free(u);
+		return NULL;
+	}
+	u->cq_ring = u->sq_ring;
+
+	u->sqes_size = p.sq_entries*sizeof(struct io_uring_sqe);
+	u->sqes = (struct io_uring_sqe*)mmap(NULL, u->sqes_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, u->fd, IORING_OFF_SQES);
+	if(MAP_FAILED==(void*)u->sqes) {
+		LOG_WARN("[uring_api] uring create failed, mmap sqes errno=%d.", errno);
+		munmap(u->sq_ring, u->sq_ring_size);
+		close(u->fd);
+		mem_pool_free(u);
+		return NULL;
+	}
+
+	sq = (char*)u->sq_ring;
+	u->sq_head = (unsigned int*)(sq + p.sq_off.head);
+	u->sq_tail = (unsigned int*)(sq + p.sq_off.tail);
+	u->sq_mask = (unsigned int*)(sq + p.sq_off.ring_mask);
+	u->sq_array = (unsigned int*)(sq + p.sq_off.array);
+	u->sq_entries = p.sq_entries;
+	u->sq_local_tail = *u->sq_tail;
+
+	cq = (char*)u->cq_ring;
+	u->cq_head = (unsigned int*)(cq + p.cq_off.head);
+	u->cq_tail = (unsigned int*)(cq + p.cq_off.tail);
+	u->cq_mask = (unsigned int*)(cq + p.cq_off.ring_mask);
+	u->cqes = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+
+	if(-1==uring_probe_poll(u)) {
+		LOG_WARN("[uring_api] uring create failed, multishot poll is not supported.");
+		uring_destroy(u);
+		return NULL;
+	}
+
+	return u;
+}
+
+struct io_uring_sqe* uring_get_sqe(struct uring_t *u)
+{
+	struct io_uring_sqe *sqe;
+	unsigned int head = __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+	unsigned int idx;
+
+	if(u->sq_local_tail - head >= u->sq_entries) {
+		return NULL;
+	}
+
+	idx = u->sq_local_tail & *u->sq_mask;
+	//sqe index same as ring index
+	u->sq_array[idx] = idx;
+	sqe = &u->sqes[idx];
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	u->sq_local_tail++;
+
+	return sqe;
+}
+
+unsigned int uring_flush_sq(struct uring_t *u)
+{
+	//publish the new entries to kernel
+	__atomic_store_n(u->sq_tail, u->sq_local_tail, __ATOMIC_RELEASE);
+
+	return u->sq_local_tail - __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+}
+
+int uring_enter(struct uring_t *u, unsigned int to_submit, unsigned int wait_nr, int timeout)
+{
+	int ret;
+	unsigned int flags = 0;
+	struct __kernel_timespec ts;
+	struct io_uring_getevents_arg arg;
+
+	if(0==to_submit && 0==wait_nr) {
+		return 0;
+	}
+
+	if(wait_nr) {
+		memset(&arg, 0, sizeof(arg));
+		if(timeout>=0) {
+			ts.tv_sec = timeout/1000;
+			ts.tv_nsec = (timeout%1000) * 1000000;
+			arg.ts = (unsigned long long)(unsigned long)&ts;
+		}
+		arg.sigmask_sz = _NSIG/8;
+		flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+		ret = sys_io_uring_enter(u->fd, to_submit, wait_nr, flags, &arg, sizeof(arg));
+	} else {
+		ret = sys_io_uring_enter(u->fd, to_submit, 0, 0, NULL, 0);
+	}
+
+	if(-1==ret && ETIME==errno) {
+		//wait timeout
+		ret = 0;
+	}
+
+	return ret;
+}
+
+int uring_submit(struct uring_t *u)
+{
+	return uring_enter(u, uring_flush_sq(u), 0, 0);
+}
+
+struct io_uring_cqe* uring_peek_cqe(struct uring_t *u)
+{
+	unsigned int head = *u->cq_head;
+	unsigned int tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+
+	if(head==tail) {
+		return NULL;
+	}
+
+	return &u->cqes[head & *u->cq_mask];
+}
+
+void uring_cq_advance(struct uring_t *u, unsigned int n)
+{
+	__atomic_store_n(u->cq_head, *u->cq_head + n, __ATOMIC_RELEASE);
+}
+
+#ifdef NET_HAVE_URING_BUF
+int uring_buf_create(struct uring_t *u, unsigned int count, unsigned int size)
+{
+	unsigned int i;
+	size_t ring_size;
+	struct io_uring_buf_reg reg;
+
+	if(u->br || 0==count || (count&(count-1)) || count>32768) {
+		return -1;
+	}
+
+	//the ring must be page aligned, the buffers follow it
+	ring_size = (count*sizeof(struct io_uring_buf) + 4095) & ~(size_t)4095;
+	u->br_size = ring_size + (size_t)count*size;
+	u->br = (struct io_uring_buf_ring*)mmap(NULL, u->br_size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+	if(MAP_FAILED==(void*)u->br) {
+		LOG_WARN("[uring_api] uring create buffers failed, mmap errno=%d.", errno);
+		u->br = NULL;
+		return -1;
+	}
+	u->bufs = (char*)u->br + ring_size;
+	u->buf_count = count;
+	u->buf_size = size;
+	u->br_tail = 0;
+
+	memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = (unsigned long long)(unsigned long)u->br;
+	reg.ring_entries = count;
+	reg.bgid = 0;
+	if(-1==sys_io_uring_register(u->fd, IORING_REGISTER_PBUF_RING, &reg, 1)) {
+		LOG_WARN("[uring_api] uring create buffers failed, register errno=%d.", errno);
+		munmap(u->br, u->br_size);
+		u->br = NULL;
+		return -1;
+	}
+
+	for(i=0; i<count; ++i) {
+		uring_buf_put(u, (unsigned short)i);
+	}
+
+	return 0;
+}
+
+char* uring_buf_addr(struct uring_t *u, unsigned short bid)
+{
+	return u->bufs + (size_t)bid*u->buf_size;
+}
+
+void uring_buf_put(struct uring_t *u, unsigned short bid)
+{
+	struct io_uring_buf *buf = &u->br->bufs[u->br_tail & (u->buf_count-1)];
+
+	buf->addr = (unsigned long long)(unsigned long)uring_buf_addr(u, bid);
+	buf->len = u->buf_size;
+	buf->bid = bid;
+	//publish the buffer to kernel
+	__atomic_store_n(&u->br->tail, ++u->br_tail, __ATOMIC_RELEASE);
+}
+#endif //NET_HAVE_URING_BUF
+
+void uring_destroy(struct uring_t *u)
+{
+	if(u) {
+		munmap(u->sqes, u->sqes_size);
+		munmap(u->sq_ring, u->sq_ring_size);
+		close(u->fd);
+#ifdef NET_HAVE_URING_BUF
+		//the operations of ring are cancelled by closing
+		if(u->br) {
+			munmap(u->br, u->br_size);
+		}
+#endif //NET_HAVE_URING_BUF
+		mem_pool_free(u);
+	}
+}
+
+#endif //NET_HAVE_URING
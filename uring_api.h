@@ -0,0 +1,146 @@
+/**********************************************************
+* file: uring_api.h
+* brief: linux io_uring ring api without liburing
+* 
+* author: qk
+* email: 
+* date: 2026-10
+* modify date: 
+**********************************************************/
+
+#ifndef _URING_API_H_
+#define _URING_API_H_
+
+#if !defined(_WIN32) && defined(__has_include)
+  #if __has_include(<linux/io_uring.h>)
+    #define NET_HAVE_URING
+  #endif
+#endif
+
+#ifdef NET_HAVE_URING
+
+#include <linux/io_uring.h>
+
+#ifdef IORING_RECV_MULTISHOT
+  //provided buffer ring (since Linux 5.19) and multishot recv (since Linux 6.0)
+  #define NET_HAVE_URING_BUF
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct uring_t;
+
+/**********************************************************
+ * brief: create io_uring object
+ * input: entries, the number of submission queue entries
+ *
+ * return: NULL error(not support), other ok
+ *********************************************************/
+struct uring_t* uring_create(unsigned int entries);
+
+/**********************************************************
+ * brief: get a free submission queue entry, the entry is
+ *        cleared and not visible to kernel until uring_submit
+ * input: u, io_uring object
+ *
+ * return: NULL submission queue is full, other ok
+ *********************************************************/
+struct io_uring_sqe* uring_get_sqe(struct uring_t *u);
+
+/**********************************************************
+ * brief: make the entries got from uring_get_sqe visible to
+ *        kernel, uring_get_sqe and uring_flush_sq must be
+ *        serialized by caller
+ * input: u, io_uring object
+ *
+ * return: the number of entries not submitted
+ *********************************************************/
+unsigned int uring_flush_sq(struct uring_t *u);
+
+/**********************************************************
+ * brief: submit the flushed entries, and wait for completion
+ *        if wait_nr>0, can be called in multi-threads
+ * input: u, io_uring object
+ *        to_submit, the number of entries to submit
+ *        wait_nr, the min number of completions to wait for
+ *        timeout, milliseconds for waiting, <0 infinite
+ *
+ * return: -1 error, >=0 the number of submitted entries
+ *********************************************************/
+int uring_enter(struct uring_t *u, unsigned int to_submit, unsigned int wait_nr, int timeout);
+
+/**********************************************************
+ * brief: flush and submit entries without waiting
+ * input: u, io_uring object
+ *
+ * return: -1 error, >=0 the number of submitted entries
+ *********************************************************/
+int uring_submit(struct uring_t *u);
+
+/**********************************************************
+ * brief: get the first completion queue entry
+ * input: u, io_uring object
+ *
+ * return: NULL no completion, other ok
+ *********************************************************/
+struct io_uring_cqe* uring_peek_cqe(struct uring_t *u);
+
+/**********************************************************
+ * brief: mark the first n completion queue entries consumed
+ * input: u, io_uring object
+ *        n, the number of consumed entries
+ *
+ * return: None
+ *********************************************************/
+void uring_cq_advance(struct uring_t *u, unsigned int n);
+
+#ifdef NET_HAVE_URING_BUF
+/**********************************************************
+ * brief: register ring of provided buffers as group 0, the
+ *        buffer is selected by the operation with
+ *        IOSQE_BUFFER_SELECT, and given back by uring_buf_put
+ * input: u, io_uring object
+ *        count, the number of buffers, power of 2
+ *        size, bytes of every buffer
+ *
+ * return: -1 error(not support), 0 ok
+ *********************************************************/
+int uring_buf_create(struct uring_t *u, unsigned int count, unsigned int size);
+
+/**********************************************************
+ * brief: get address of provided buffer
+ * input: u, io_uring object
+ *        bid, buffer id in completion queue entry
+ *
+ * return: buffer address
+ *********************************************************/
+char* uring_buf_addr(struct uring_t *u, unsigned short bid);
+
+/**********************************************************
+ * brief: give the consumed buffer back to kernel, it must be
+ *        serialized by caller
+ * input: u, io_uring object
+ *        bid, buffer id in completion queue entry
+ *
+ * return: None
+ *********************************************************/
+void uring_buf_put(struct uring_t *u, unsigned short bid);
+#endif //NET_HAVE_URING_BUF
+
+/**********************************************************
+ * brief: destroy io_uring object
+ * input: u, io_uring object
+ *
+ * return: None
+ *********************************************************/
+void uring_destroy(struct uring_t *u);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //NET_HAVE_URING
+
+#endif//_URING_API_H_